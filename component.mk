@@ -5,3 +5,23 @@ COMPONENT_DOXYGEN_INCLUDE_PATH := src/include/config.hpp
 COMPONENT_DOXYGEN_PREDEFINED := \
 	FSTR_INLINE= \
 	FSTR_PACKED=
+
+# Store type information in object headers, required by FSTR::Variant
+COMPONENT_VARS += FSTR_TYPE_INFO
+FSTR_TYPE_INFO ?= 0
+GLOBAL_CFLAGS += -DFSTR_TYPE_INFO=$(FSTR_TYPE_INFO)
+
+# Collect access statistics for each object, see FSTR::Stats
+COMPONENT_VARS += FSTR_STATS
+FSTR_STATS ?= 0
+GLOBAL_CFLAGS += -DFSTR_STATS=$(FSTR_STATS)
+
+# Redirect object reads via the active FSTR::RamCache
+COMPONENT_VARS += FSTR_RAM_CACHE
+FSTR_RAM_CACHE ?= 0
+GLOBAL_CFLAGS += -DFSTR_RAM_CACHE=$(FSTR_RAM_CACHE)
+
+# Register all objects so they can be checked at startup, see FSTR::Catalogue
+COMPONENT_VARS += FSTR_CATALOGUE
+FSTR_CATALOGUE ?= 0
+GLOBAL_CFLAGS += -DFSTR_CATALOGUE=$(FSTR_CATALOGUE)
@@ -0,0 +1,221 @@
+/**
+ * AsyncStream.cpp
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#include "include/FlashString/AsyncStream.hpp"
+#include <Platform/System.h>
+
+namespace FSTR
+{
+static_assert(AsyncStream::blockSize != 0 && AsyncStream::blockSize <= 0xffff, "Bad FSTR_ASYNC_BLOCK_SIZE");
+
+AsyncStream* AsyncStream::queueHead;
+AsyncStream* AsyncStream::queueTail;
+bool AsyncStream::taskQueued;
+
+const AsyncStream::Block* AsyncStream::findBlock(size_t offset) const
+{
+	for(auto& block : blocks) {
+		if(block.ready && block.offset == offset) {
+			return &block;
+		}
+	}
+	return nullptr;
+}
+
+void AsyncStream::readBlock(Block& block)
+{
+	auto len = object.length();
+	block.length = (block.offset < len) ? object.readFlash(block.offset, block.data, blockSize) : 0;
+	block.ready = true;
+}
+
+AsyncStream::Block& AsyncStream::loadBlock(size_t offset)
+{
+	auto found = findBlock(offset);
+	if(found != nullptr) {
+		return const_cast<Block&>(*found);
+	}
+
+	// Not yet prefetched, so read it now
+	Block* block;
+	if(pendingBlock != nullptr && pendingBlock->offset == offset) {
+		block = pendingBlock;
+	} else {
+		// Keep the following block if we have it
+		block = (blocks[0].ready && blocks[0].offset == offset + blockSize) ? &blocks[1] : &blocks[0];
+		block->offset = offset;
+	}
+	cancelPrefetch();
+	readBlock(*block);
+	return *block;
+}
+
+uint16_t AsyncStream::readMemoryBlock(char* data, int bufSize)
+{
+	if(data == nullptr || bufSize <= 0) {
+		return 0;
+	}
+
+	auto len = object.length();
+	auto pos = readPos;
+	size_t count = 0;
+	while(count < size_t(bufSize) && pos < len) {
+		auto start = blockStart(pos);
+		// Only wait for the first block
+		auto block = (count == 0) ? &loadBlock(start) : findBlock(start);
+		if(block == nullptr) {
+			break;
+		}
+		auto offset = pos - start;
+		if(offset >= block->length) {
+			break;
+		}
+		auto n = std::min(size_t(bufSize) - count, size_t(block->length - offset));
+		memcpy(data + count, &block->data[offset], n);
+		count += n;
+		pos += n;
+	}
+
+	requestPrefetch();
+	return std::min(count, size_t(0xffff));
+}
+
+int AsyncStream::seekFrom(int offset, SeekOrigin origin)
+{
+	size_t newPos;
+	switch(origin) {
+	case SeekOrigin::Start:
+		newPos = offset;
+		break;
+	case SeekOrigin::Current:
+		newPos = readPos + offset;
+		break;
+	case SeekOrigin::End:
+		newPos = object.length() + offset;
+		break;
+	default:
+		return -1;
+	}
+
+	if(newPos > object.length()) {
+		return -1;
+	}
+
+	readPos = newPos;
+	requestPrefetch();
+	return readPos;
+}
+
+/*
+ * Ensure the current and following blocks are loaded, or queued for loading.
+ * Only one block per stream is queued at a time so all streams get a fair share.
+ */
+void AsyncStream::requestPrefetch()
+{
+	if(pendingBlock != nullptr) {
+		return;
+	}
+
+	auto len = object.length();
+	auto current = blockStart(readPos);
+	for(auto offset : {current, current + blockSize}) {
+		if(offset >= len) {
+			return;
+		}
+		if(findBlock(offset) != nullptr) {
+			continue;
+		}
+
+		// Don't overwrite the other block we want
+		auto& other = blocks[0];
+		bool wanted = other.ready && (other.offset == current || other.offset == current + blockSize);
+		pendingBlock = wanted ? &blocks[1] : &blocks[0];
+		pendingBlock->offset = offset;
+		pendingBlock->ready = false;
+
+		if(queueTail == nullptr) {
+			queueHead = this;
+		} else {
+			queueTail->next = this;
+		}
+		queueTail = this;
+
+		if(!taskQueued) {
+			taskQueued = System.queueCallback(taskCallback);
+		}
+		return;
+	}
+}
+
+void AsyncStream::cancelPrefetch()
+{
+	if(pendingBlock == nullptr) {
+		return;
+	}
+	pendingBlock = nullptr;
+
+	AsyncStream* prev = nullptr;
+	for(auto stream = queueHead; stream != nullptr; prev = stream, stream = stream->next) {
+		if(stream != this) {
+			continue;
+		}
+		if(prev == nullptr) {
+			queueHead = next;
+		} else {
+			prev->next = next;
+		}
+		if(queueTail == this) {
+			queueTail = prev;
+		}
+		next = nullptr;
+		break;
+	}
+}
+
+bool AsyncStream::service()
+{
+	auto stream = queueHead;
+	if(stream == nullptr) {
+		return false;
+	}
+
+	queueHead = stream->next;
+	if(queueHead == nullptr) {
+		queueTail = nullptr;
+	}
+	stream->next = nullptr;
+
+	auto block = stream->pendingBlock;
+	stream->pendingBlock = nullptr;
+	stream->readBlock(*block);
+	// Re-joins the end of the queue if there's more to do
+	stream->requestPrefetch();
+
+	return queueHead != nullptr;
+}
+
+void AsyncStream::taskCallback(void*)
+{
+	taskQueued = false;
+	if(service() && !taskQueued) {
+		taskQueued = System.queueCallback(taskCallback);
+	}
+}
+
+} // namespace FSTR
@@ -0,0 +1,152 @@
+/**
+ * Catalogue.cpp
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#include "include/FlashString/Catalogue.hpp"
+#include "include/FlashString/ObjectBase.hpp"
+#include <Print.h>
+#include <esp_systemapi.h>
+
+#if FSTR_CATALOGUE
+// Provided by the linker
+extern "C" const FSTR::ObjectBase* const __start_fstr_catalogue[];
+extern "C" const FSTR::ObjectBase* const __stop_fstr_catalogue[];
+#endif
+
+namespace FSTR
+{
+namespace Catalogue
+{
+namespace
+{
+#ifdef ARCH_ESP8266
+// Only the first 1MB of flash can be mapped
+constexpr uint32_t flashMapEnd = 0x40300000U;
+#endif
+
+} // namespace
+
+const char* toString(Error error)
+{
+	switch(error) {
+	case Error::none:
+		return "none";
+	case Error::alignment:
+		return "alignment";
+	case Error::address:
+		return "address";
+	case Error::header:
+		return "header";
+	case Error::bounds:
+		return "bounds";
+	case Error::digest:
+		return "digest";
+	default:
+		return "?";
+	}
+}
+
+size_t Report::printTo(Print& p) const
+{
+	size_t n = p.printf(_F("FlashString catalogue: %u objects, %u bytes, %u failures, %u cycles"), objects,
+						unsigned(bytes), failures, unsigned(cycles));
+	if(firstFailure != nullptr) {
+		n += p.printf(_F(", first %s at %p"), toString(firstError), firstFailure);
+	}
+	return n;
+}
+
+Error check(const ObjectBase& object, bool verifyDigest)
+{
+	auto addr = uintptr_t(&object);
+	if(addr & 3) {
+		return Error::alignment;
+	}
+
+#ifndef ARCH_HOST
+	if(!isFlashPtr(&object)) {
+		return Error::address;
+	}
+#endif
+
+	// A copy holds a pointer, not a length
+	if(object.isCopy()) {
+		return Error::header;
+	}
+
+	auto length = object.length();
+	auto elementSize = object.storedElementSize();
+	if(elementSize != 0 && length % elementSize != 0) {
+		return Error::header;
+	}
+
+#ifdef ARCH_ESP8266
+	auto end = uint32_t(object.data()) + length;
+	if(end < addr || end > flashMapEnd) {
+		return Error::bounds;
+	}
+#endif
+
+	if(verifyDigest && object.hasDigest() && object.digest() != object.calculateDigest()) {
+		return Error::digest;
+	}
+
+	return Error::none;
+}
+
+#if FSTR_CATALOGUE
+
+unsigned count()
+{
+	return __stop_fstr_catalogue - __start_fstr_catalogue;
+}
+
+const ObjectBase* entryAt(unsigned index)
+{
+	return (index < count()) ? __start_fstr_catalogue[index] : nullptr;
+}
+
+Report validate(bool verifyDigests, FailureCallback callback)
+{
+	Report report{};
+	auto start = esp_get_ccount();
+	for(auto entry = __start_fstr_catalogue; entry != __stop_fstr_catalogue; ++entry) {
+		auto& object = **entry;
+		++report.objects;
+		auto err = check(object, verifyDigests);
+		if(err == Error::none) {
+			report.bytes += object.length();
+			continue;
+		}
+		if(report.failures++ == 0) {
+			report.firstFailure = &object;
+			report.firstError = err;
+		}
+		if(callback != nullptr) {
+			callback(object, err);
+		}
+	}
+	report.cycles = esp_get_ccount() - start;
+	return report;
+}
+
+#endif
+
+} // namespace Catalogue
+
+} // namespace FSTR
@@ -0,0 +1,43 @@
+/**
+ * Compressed.cpp
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#include "include/FlashString/Compressed.hpp"
+#include "include/FlashString/CompressedStream.hpp"
+
+namespace FSTR
+{
+size_t Compressed::printTo(Print& p) const
+{
+	CompressedStream stream(*this);
+	char buffer[256];
+	size_t total = 0;
+	size_t readCount;
+	while((readCount = stream.readMemoryBlock(buffer, sizeof(buffer))) > 0) {
+		auto writeCount = p.write(buffer, readCount);
+		total += writeCount;
+		if(writeCount != readCount) {
+			break;
+		}
+		stream.seek(readCount);
+	}
+
+	return total;
+}
+
+} // namespace FSTR
@@ -0,0 +1,222 @@
+/**
+ * CompressedStream.cpp
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#include "include/FlashString/CompressedStream.hpp"
+#include <new>
+
+/*
+ * LZSS encoding
+ *
+ * Content is a sequence of groups, each starting with a flag byte. Bits are taken from the flag
+ * byte starting at bit 0, and each describes one token which follows:
+ *
+ * 	1: Literal byte
+ * 	0: Match, 16-bit little-endian value. The lower `windowBits` give (offset - 1),
+ * 	   the remaining upper bits give (length - minMatchLength).
+ *
+ */
+
+namespace FSTR
+{
+namespace
+{
+constexpr uint8_t minWindowBits = 8;
+constexpr uint8_t maxWindowBits = 12;
+constexpr uint8_t minMatchLength = 3;
+} // namespace
+
+CompressedStream::CompressedStream(const Compressed& object) : object(object), header(object.header())
+{
+	switch(header.method) {
+	case Compression::lzss:
+		if(header.windowBits < minWindowBits || header.windowBits > maxWindowBits) {
+			break;
+		}
+		window = new(std::nothrow) uint8_t[1U << header.windowBits];
+		if(window == nullptr) {
+			break;
+		}
+		windowMask = (1U << header.windowBits) - 1;
+		return;
+
+	case Compression::gzip:
+		return;
+
+	case Compression::none:
+	default:;
+	}
+
+	// Invalid object
+	header = CompressionHeader{};
+}
+
+void CompressedStream::reset()
+{
+	readPos = 0;
+	decodePos = 0;
+	inputPos = 0;
+	inputLength = 0;
+	inputIndex = 0;
+	flags = 0;
+	flagCount = 0;
+	matchLength = 0;
+}
+
+int CompressedStream::getByte()
+{
+	if(inputIndex >= inputLength) {
+		inputLength = object.readFlash(sizeof(CompressionHeader) + inputPos, input, sizeof(input));
+		if(inputLength == 0) {
+			return -1;
+		}
+		inputPos += inputLength;
+		inputIndex = 0;
+	}
+
+	return input[inputIndex++];
+}
+
+void CompressedStream::decode(size_t limit)
+{
+	limit = std::min(limit, size_t(header.length));
+
+	while(decodePos < limit) {
+		if(matchLength != 0) {
+			window[decodePos & windowMask] = window[(decodePos - matchOffset) & windowMask];
+			++decodePos;
+			--matchLength;
+			continue;
+		}
+
+		if(flagCount == 0) {
+			int c = getByte();
+			if(c < 0) {
+				break;
+			}
+			flags = c;
+			flagCount = 8;
+		}
+
+		bool literal = flags & 0x01;
+		flags >>= 1;
+		--flagCount;
+
+		if(literal) {
+			int c = getByte();
+			if(c < 0) {
+				break;
+			}
+			window[decodePos & windowMask] = c;
+			++decodePos;
+			continue;
+		}
+
+		int lo = getByte();
+		int hi = getByte();
+		if(lo < 0 || hi < 0) {
+			break;
+		}
+		uint16_t token = lo | (hi << 8);
+		matchOffset = (token & windowMask) + 1;
+		matchLength = (token >> header.windowBits) + minMatchLength;
+		if(matchOffset > decodePos) {
+			// Corrupt data
+			break;
+		}
+	}
+
+	if(decodePos < limit) {
+		// Data is truncated or corrupt, so prevent further attempts to decode
+		header.length = decodePos;
+	}
+}
+
+uint16_t CompressedStream::readMemoryBlock(char* data, int bufSize)
+{
+	if(bufSize <= 0) {
+		return 0;
+	}
+
+	switch(header.method) {
+	case Compression::gzip:
+		return object.readFlash(sizeof(CompressionHeader) + readPos, reinterpret_cast<uint8_t*>(data), bufSize);
+
+	case Compression::lzss:
+		break;
+
+	default:
+		return 0;
+	}
+
+	auto windowSize = windowMask + 1;
+	decode(readPos + std::min(size_t(bufSize), windowSize));
+
+	size_t count = std::min(size_t(bufSize), decodePos - readPos);
+	auto offset = readPos & windowMask;
+	auto n = std::min(count, windowSize - offset);
+	memcpy(data, &window[offset], n);
+	memcpy(data + n, window, count - n);
+	return count;
+}
+
+int CompressedStream::seekFrom(int offset, SeekOrigin origin)
+{
+	size_t newPos;
+	switch(origin) {
+	case SeekOrigin::Start:
+		newPos = offset;
+		break;
+	case SeekOrigin::Current:
+		newPos = readPos + offset;
+		break;
+	case SeekOrigin::End:
+		newPos = outputLength() + offset;
+		break;
+	default:
+		return -1;
+	}
+
+	if(newPos > outputLength()) {
+		return -1;
+	}
+
+	if(header.method != Compression::lzss) {
+		readPos = newPos;
+		return readPos;
+	}
+
+	auto windowSize = windowMask + 1;
+	if(newPos + windowSize < decodePos) {
+		// Data no longer in window
+		reset();
+	}
+
+	while(decodePos < newPos) {
+		readPos = decodePos;
+		decode(std::min(newPos, readPos + windowSize));
+		if(decodePos == readPos) {
+			return -1;
+		}
+	}
+
+	readPos = newPos;
+	return readPos;
+}
+
+} // namespace FSTR
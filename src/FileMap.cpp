@@ -0,0 +1,69 @@
+/**
+ * FileMap.cpp
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#include "include/FlashString/FileMap.hpp"
+#include "include/FlashString/Stream.hpp"
+#include "include/FlashString/CompressedStream.hpp"
+#include "include/FlashString/Print.hpp"
+
+namespace FSTR
+{
+IDataSourceStream* FileEntry::createStream() const
+{
+	if(content_ == nullptr) {
+		return nullptr;
+	}
+	if(compression_ == Compression::none) {
+		return new Stream(*content_);
+	}
+	return new CompressedStream(content_->as<Compressed>());
+}
+
+size_t FileEntry::printTo(Print& p) const
+{
+	if(!*this) {
+		return p.print("(invalid)");
+	}
+
+	size_t count = path().printTo(p);
+	count += p.print(" (");
+	count += p.print(unsigned(size_));
+	count += p.print(" bytes, ");
+	count += mimeType().printTo(p);
+	auto encoding = contentEncoding();
+	if(encoding != nullptr) {
+		count += p.print(", ");
+		count += p.print(encoding);
+	}
+	count += p.print(')');
+	return count;
+}
+
+size_t FileMap::printTo(Print& p) const
+{
+	BufferedPrint<FSTR_PRINT_BUFFER_SIZE> out(p);
+	size_t count = 0;
+	for(auto entry : *this) {
+		count += entry.printTo(out);
+		count += out.println();
+	}
+	return count;
+}
+
+} // namespace FSTR
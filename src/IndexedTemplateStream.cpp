@@ -0,0 +1,134 @@
+/**
+ * IndexedTemplateStream.cpp
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#include "include/FlashString/IndexedTemplateStream.hpp"
+
+namespace FSTR
+{
+constexpr uint16_t TemplateSegment::noVariable;
+
+IndexedTemplateStream::IndexedTemplateStream(const String& content, const Array<TemplateSegment>& segments,
+											 const Vector<String>& variables)
+	: content(content), segments(segments), variables(variables), values(new ::String[variables.length()])
+{
+}
+
+void IndexedTemplateStream::setVar(unsigned index, const ::String& value)
+{
+	if(index < variables.length()) {
+		values[index] = value;
+	}
+}
+
+bool IndexedTemplateStream::setVar(const char* name, const ::String& value)
+{
+	int index = variables.indexOf(name, false);
+	if(index < 0) {
+		return false;
+	}
+	values[index] = value;
+	return true;
+}
+
+void IndexedTemplateStream::loadSegment()
+{
+	auto count = segments.length();
+	while(segmentIndex < count) {
+		segment = segments[segmentIndex];
+		value = (segment.variable == TemplateSegment::noVariable) ? ::String() : getValue(segment.variable);
+		if(segmentLength() != 0) {
+			return;
+		}
+		++segmentIndex;
+	}
+	segment = TemplateSegment{};
+	value = ::String();
+}
+
+uint16_t IndexedTemplateStream::readMemoryBlock(char* data, int bufSize)
+{
+	if(isFinished() || bufSize <= 0) {
+		return 0;
+	}
+
+	size_t total = 0;
+	size_t pos = segmentPos;
+	// Literal text
+	if(pos < segment.length) {
+		total = content.readFlash(segment.offset + pos, data, std::min(size_t(bufSize), segment.length - pos));
+		pos += total;
+	}
+	// Followed by variable value
+	if(total < size_t(bufSize) && pos >= segment.length) {
+		auto valuePos = pos - segment.length;
+		auto count = std::min(size_t(bufSize) - total, value.length() - valuePos);
+		memcpy(data + total, value.c_str() + valuePos, count);
+		total += count;
+	}
+
+	return total;
+}
+
+int IndexedTemplateStream::seekFrom(int offset, SeekOrigin origin)
+{
+	start();
+
+	if(origin == SeekOrigin::Start && offset == 0) {
+		segmentIndex = 0;
+		segmentPos = 0;
+		readPos = 0;
+		loadSegment();
+		return 0;
+	}
+
+	if(origin != SeekOrigin::Current || offset < 0) {
+		return -1;
+	}
+
+	size_t remaining = offset;
+	while(remaining != 0) {
+		if(isFinished()) {
+			return -1;
+		}
+		auto count = std::min(remaining, segmentLength() - segmentPos);
+		segmentPos += count;
+		readPos += count;
+		remaining -= count;
+		if(segmentPos == segmentLength()) {
+			++segmentIndex;
+			segmentPos = 0;
+			loadSegment();
+		}
+	}
+
+	return readPos;
+}
+
+const char* IndexedTemplateStream::getStreamPointer(size_t& length)
+{
+	if(isFinished() || segmentPos >= segment.length) {
+		length = 0;
+		return nullptr;
+	}
+
+	length = segment.length - segmentPos;
+	return reinterpret_cast<const char*>(content.data()) + segment.offset + segmentPos;
+}
+
+} // namespace FSTR
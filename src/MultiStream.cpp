@@ -0,0 +1,128 @@
+/**
+ * MultiStream.cpp
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#include "include/FlashString/MultiStream.hpp"
+
+namespace FSTR
+{
+constexpr unsigned MultiStream::maxParts;
+
+bool MultiStream::add(const ObjectBase& object, size_t offset, size_t length)
+{
+	if(partCount >= maxParts) {
+		return false;
+	}
+
+	auto objectLength = object.length();
+	offset = std::min(offset, objectLength);
+	length = std::min(length, objectLength - offset);
+	parts[partCount++] = Part{&object, nullptr, offset, length};
+	totalLength += length;
+	return true;
+}
+
+bool MultiStream::add(const char* data, size_t length)
+{
+	if(partCount >= maxParts) {
+		return false;
+	}
+
+	parts[partCount++] = Part{nullptr, data, 0, length};
+	totalLength += length;
+	return true;
+}
+
+void MultiStream::clear()
+{
+	partCount = 0;
+	totalLength = 0;
+	readPos = 0;
+	partIndex = 0;
+	partStart = 0;
+}
+
+size_t MultiStream::readPart(const Part& part, size_t offset, char* buffer, size_t count)
+{
+	count = std::min(count, part.length - offset);
+	if(part.object == nullptr) {
+		memcpy(buffer, part.ramData + offset, count);
+		return count;
+	}
+
+	Stats::Measure measure(*part.object, Stats::Event::stream);
+	count = part.object->readFlash(part.offset + offset, buffer, count);
+	measure.setBytes(count);
+	return count;
+}
+
+uint16_t MultiStream::readMemoryBlock(char* data, int bufSize)
+{
+	if(bufSize <= 0) {
+		return 0;
+	}
+
+	size_t count = 0;
+	size_t offset = readPos - partStart;
+	for(unsigned i = partIndex; i < partCount && count < size_t(bufSize); ++i) {
+		count += readPart(parts[i], offset, data + count, bufSize - count);
+		offset = 0;
+	}
+	return count;
+}
+
+void MultiStream::locate(size_t pos)
+{
+	// Usually moving forward, so search from current part
+	if(pos < partStart) {
+		partIndex = 0;
+		partStart = 0;
+	}
+	while(partIndex < partCount && pos >= partStart + parts[partIndex].length) {
+		partStart += parts[partIndex].length;
+		++partIndex;
+	}
+}
+
+int MultiStream::seekFrom(int offset, SeekOrigin origin)
+{
+	size_t newPos;
+	switch(origin) {
+	case SeekOrigin::Start:
+		newPos = offset;
+		break;
+	case SeekOrigin::Current:
+		newPos = readPos + offset;
+		break;
+	case SeekOrigin::End:
+		newPos = totalLength + offset;
+		break;
+	default:
+		return -1;
+	}
+
+	if(newPos > totalLength) {
+		return -1;
+	}
+
+	readPos = newPos;
+	locate(readPos);
+	return readPos;
+}
+
+} // namespace FSTR
@@ -18,23 +18,49 @@
  ****/
 
 #include "include/FlashString/ObjectBase.hpp"
+#include "include/FlashString/Utility.hpp"
+#include "include/FlashString/Slice.hpp"
 #include <esp_spi_flash.h>
 
 namespace FSTR
 {
 const ObjectBase ObjectBase::empty_{ObjectBase::lengthInvalid};
 constexpr uint32_t ObjectBase::copyBit;
+constexpr uint32_t ObjectBase::hashBit;
+constexpr uint32_t ObjectBase::typeBit;
+constexpr uint32_t ObjectBase::digestBit;
+
+static_assert(FSTR_DIGEST_LENGTH_FLAGS == ObjectBase::digestBit, "FSTR_DIGEST_LENGTH_FLAGS incorrect");
 
 size_t ObjectBase::readFlash(size_t offset, void* buffer, size_t count) const
 {
+	Stats::Measure measure(*this, Stats::Event::readFlash);
 	auto len = length();
 	if(offset >= len) {
 		return 0;
 	}
 
 	count = std::min(len - offset, count);
+#if FSTR_RAM_CACHE
+	auto cached = cachedData();
+	if(cached != nullptr) {
+		memcpy(buffer, cached + offset, count);
+		measure.setBytes(count);
+		return count;
+	}
+#endif
 	auto addr = flashmem_get_address(data() + offset);
-	return flashmem_read(buffer, addr, count);
+	count = flashmem_read(buffer, addr, count);
+	measure.setBytes(count);
+	return count;
+}
+
+Slice ObjectBase::slice(size_t offset, size_t length) const
+{
+	if(isCopy() && !isNull()) {
+		return reinterpret_cast<const ObjectBase*>(flashLength_ & ~copyBit)->slice(offset, length);
+	}
+	return Slice(*this, offset, length);
 }
 
 size_t ObjectBase::length() const
@@ -44,7 +70,95 @@ size_t ObjectBase::length() const
 	} else if(isCopy()) {
 		return reinterpret_cast<const ObjectBase*>(flashLength_ & ~copyBit)->length();
 	} else {
-		return flashLength_;
+		return decodeLength(flashLength_);
+	}
+}
+
+bool ObjectBase::hasHash() const
+{
+	if(isNull()) {
+		return false;
+	} else if(isCopy()) {
+		return reinterpret_cast<const ObjectBase*>(flashLength_ & ~copyBit)->hasHash();
+	} else {
+		return (flashLength_ & hashBit) != 0;
+	}
+}
+
+uint32_t ObjectBase::storedHash() const
+{
+	if(isNull()) {
+		return 0;
+	} else if(isCopy()) {
+		return reinterpret_cast<const ObjectBase*>(flashLength_ & ~copyBit)->storedHash();
+	} else if(flashLength_ & hashBit) {
+		// Hash is stored immediately before the object
+		return (&flashLength_)[-1];
+	} else {
+		return 0;
+	}
+}
+
+bool ObjectBase::hasDigest() const
+{
+	if(isNull()) {
+		return false;
+	} else if(isCopy()) {
+		return reinterpret_cast<const ObjectBase*>(flashLength_ & ~copyBit)->hasDigest();
+	} else {
+		return (flashLength_ & digestBit) != 0;
+	}
+}
+
+uint32_t ObjectBase::digest() const
+{
+	if(isCopy() && !isNull()) {
+		return reinterpret_cast<const ObjectBase*>(flashLength_ & ~copyBit)->digest();
+	}
+	if(flashLength_ & digestBit) {
+		// Digest is stored immediately before the object, or its hash
+		return (&flashLength_)[(flashLength_ & hashBit) ? -2 : -1];
+	}
+
+	return calculateDigest();
+}
+
+uint32_t ObjectBase::calculateDigest() const
+{
+	uint8_t buffer[compareChunkSize];
+	uint32_t res = Hash::offsetBasis;
+	size_t offset = 0;
+	size_t count;
+	while((count = readFlash(offset, buffer, sizeof(buffer))) != 0) {
+		res = Hash::updateDigest(res, buffer, count);
+		offset += count;
+	}
+	return res;
+}
+
+Type ObjectBase::type() const
+{
+	if(isNull()) {
+		return Type::none;
+	} else if(isCopy()) {
+		return reinterpret_cast<const ObjectBase*>(flashLength_ & ~copyBit)->type();
+	} else if(flashLength_ & typeBit) {
+		return Type((flashLength_ >> typeShift) & 0x1F);
+	} else {
+		return Type::none;
+	}
+}
+
+size_t ObjectBase::storedElementSize() const
+{
+	if(isNull()) {
+		return 0;
+	} else if(isCopy()) {
+		return reinterpret_cast<const ObjectBase*>(flashLength_ & ~copyBit)->storedElementSize();
+	} else if(flashLength_ & typeBit) {
+		return 1 + ((flashLength_ >> typeSizeShift) & 0x07);
+	} else {
+		return 0;
 	}
 }
 
@@ -63,7 +177,7 @@ const uint8_t* ObjectBase::data() const
 	}
 
 	// Cannot yet differentiate memory addresses on Host
-#ifndef ARCH_HOST
+#if FSTR_CHECK_FLASH_PTR && !defined(ARCH_HOST)
 	// Check we've got a real flash pointer
 	assert(isFlashPtr(ptr));
 #endif
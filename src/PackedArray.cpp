@@ -0,0 +1,84 @@
+/**
+ * PackedArray.cpp
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#include "include/FlashString/PackedArray.hpp"
+
+/*
+ * Each value is stored as a little-endian base-128 varint: 7 bits per byte, with the top bit set
+ * on all but the last byte. Values are zigzag-encoded differences from the previous value in
+ * the block, so the first value in each block is stored in full.
+ *
+ * See tools/fstr-pack.py.
+ */
+
+namespace FSTR
+{
+constexpr uint8_t PackedArrayHeader::flagSigned;
+
+bool PackedDecoder::seek(const ObjectBase& object, unsigned block)
+{
+	PackedArrayHeader hdr{};
+	if(object.read(0, &hdr, sizeof(hdr)) != sizeof(hdr) || hdr.blockSize == 0) {
+		return false;
+	}
+	unsigned blockCount = (hdr.count + hdr.blockSize - 1) / hdr.blockSize;
+	if(block >= blockCount) {
+		return false;
+	}
+	uint32_t blockOffset;
+	auto tableOffset = sizeof(hdr) + block * sizeof(uint32_t);
+	if(object.read(tableOffset, &blockOffset, sizeof(blockOffset)) != sizeof(blockOffset)) {
+		return false;
+	}
+
+	this->object = &object;
+	offset = sizeof(hdr) + blockCount * sizeof(uint32_t) + blockOffset;
+	value = 0;
+	bufPos = bufLength = 0;
+	return true;
+}
+
+void PackedDecoder::fill()
+{
+	bufPos = 0;
+	bufLength = (object == nullptr) ? 0 : object->read(offset, buffer, sizeof(buffer));
+	offset += bufLength;
+	if(bufLength == 0) {
+		// Truncated data: terminate any varint being read
+		buffer[0] = 0;
+		bufLength = 1;
+	}
+}
+
+uint64_t PackedDecoder::next()
+{
+	uint64_t n = 0;
+	for(unsigned shift = 0; shift < 64; shift += 7) {
+		auto c = nextByte();
+		n |= uint64_t(c & 0x7f) << shift;
+		if((c & 0x80) == 0) {
+			break;
+		}
+	}
+	// Undo zigzag encoding
+	value += (n >> 1) ^ -(n & 1);
+	return value;
+}
+
+} // namespace FSTR
@@ -0,0 +1,118 @@
+/**
+ * PrefixVector.cpp
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#include "include/FlashString/PrefixVector.hpp"
+
+namespace FSTR
+{
+int PrefixMatch::indexAt(unsigned pos) const
+{
+	return (pos < length()) ? vector.indexAt(first + pos) : -1;
+}
+
+const String& PrefixMatch::operator[](unsigned pos) const
+{
+	auto index = indexAt(pos);
+	return (index < 0) ? String::empty() : vector.valueAt(index);
+}
+
+void PrefixVector::narrow(unsigned& first, unsigned& last, unsigned pos, char c, Stats::Measure& measure) const
+{
+	/*
+	 * Entries of exactly `pos` characters come first, followed by the others
+	 * in order of the character at `pos`.
+	 * Compare returns <0 if entry at position i sorts before `c`.
+	 */
+	// Case folding must match tools/fstr-prefix.py
+	auto folded = Hash::foldCase(c);
+	auto compare = [&](unsigned i) -> int {
+		measure.probe();
+		auto& entry = valueAt(index()[i]);
+		if(entry.length() <= pos) {
+			return -1;
+		}
+		return int(Hash::foldCase(entry[pos])) - int(folded);
+	};
+
+	// Lower bound: first entry not less than c
+	unsigned lo = first;
+	unsigned hi = last;
+	while(lo < hi) {
+		auto mid = lo + (hi - lo) / 2;
+		if(compare(mid) < 0) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	first = lo;
+
+	// Upper bound: first entry greater than c
+	hi = last;
+	while(lo < hi) {
+		auto mid = lo + (hi - lo) / 2;
+		if(compare(mid) <= 0) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	last = lo;
+}
+
+PrefixMatch PrefixVector::startsWith(const char* prefix, size_t length) const
+{
+	Stats::Measure measure(*this, Stats::Event::lookup);
+	unsigned first = 0;
+	unsigned last = indexLength();
+	if(prefix != nullptr) {
+		if(length == 0) {
+			length = strlen(prefix);
+		}
+		for(unsigned pos = 0; pos < length && first < last; ++pos) {
+			narrow(first, last, pos, prefix[pos], measure);
+		}
+	}
+	return PrefixMatch(*this, first, last);
+}
+
+int PrefixVector::longestMatch(const char* text, size_t length) const
+{
+	if(text == nullptr) {
+		return -1;
+	}
+	if(length == 0) {
+		length = strlen(text);
+	}
+
+	Stats::Measure measure(*this, Stats::Event::lookup);
+	int match = -1;
+	unsigned first = 0;
+	unsigned last = indexLength();
+	for(unsigned pos = 0; pos < length && first < last; ++pos) {
+		narrow(first, last, pos, text[pos], measure);
+		// An entry equal to the prefix so far sorts first
+		if(first < last && valueAt(index()[first]).length() == pos + 1) {
+			match = index()[first];
+		}
+	}
+	return match;
+}
+
+} // namespace FSTR
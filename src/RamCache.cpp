@@ -0,0 +1,204 @@
+/**
+ * RamCache.cpp
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#include "include/FlashString/RamCache.hpp"
+#include <esp_spi_flash.h>
+#include <stdlib.h>
+
+namespace FSTR
+{
+RamCache* RamCache::active;
+
+#if FSTR_RAM_CACHE
+const uint8_t* ObjectBase::cachedData() const
+{
+	auto cache = RamCache::getActive();
+	return (cache == nullptr) ? nullptr : cache->lookup(*this);
+}
+#endif
+
+RamCache::~RamCache()
+{
+	if(active == this) {
+		active = nullptr;
+	}
+	clear();
+}
+
+RamCache::Entry* RamCache::findEntry(const ObjectBase& object) const
+{
+	// Avoid walking the list for every chunk read from a large object
+	if(object.length() > maxLength) {
+		return nullptr;
+	}
+	auto flashData = object.data();
+	for(auto entry = head; entry != nullptr; entry = entry->next) {
+		if(entry->flashData == flashData) {
+			return entry;
+		}
+	}
+	return nullptr;
+}
+
+const uint8_t* RamCache::lookup(const ObjectBase& object)
+{
+	auto entry = findEntry(object);
+	if(entry == nullptr) {
+		return nullptr;
+	}
+	++hitCount;
+	if(entry != head) {
+		unlink(entry);
+		pushFront(entry);
+	}
+	return entry->data();
+}
+
+const uint8_t* RamCache::get(const ObjectBase& object)
+{
+	auto data = lookup(object);
+	if(data != nullptr) {
+		return data;
+	}
+
+	++missCount;
+	if(object.length() > maxObjectSize) {
+		return nullptr;
+	}
+	return load(object);
+}
+
+const uint8_t* RamCache::find(const ObjectBase& object) const
+{
+	auto entry = findEntry(object);
+	return (entry == nullptr) ? nullptr : entry->data();
+}
+
+bool RamCache::remove(const ObjectBase& object)
+{
+	auto entry = findEntry(object);
+	if(entry == nullptr) {
+		return false;
+	}
+	release(entry);
+	return true;
+}
+
+void RamCache::clear()
+{
+	while(head != nullptr) {
+		release(head);
+	}
+}
+
+size_t RamCache::read(const ObjectBase& object, size_t offset, void* buffer, size_t count)
+{
+	auto len = object.length();
+	if(offset >= len) {
+		return 0;
+	}
+
+	count = std::min(len - offset, count);
+	auto data = lookup(object);
+	if(data != nullptr) {
+		memcpy(buffer, data + offset, count);
+		return count;
+	}
+
+	// Don't use readFlash() as that may come back here
+	auto addr = flashmem_get_address(object.data() + offset);
+	return flashmem_read(buffer, addr, count);
+}
+
+const uint8_t* RamCache::load(const ObjectBase& object)
+{
+	auto existing = findEntry(object);
+	if(existing != nullptr) {
+		return existing->data();
+	}
+
+	auto length = object.length();
+	auto size = entrySize(length);
+	if(size > budget || !evict(size)) {
+		return nullptr;
+	}
+
+	auto entry = static_cast<Entry*>(malloc(size));
+	if(entry == nullptr) {
+		return nullptr;
+	}
+
+	entry->flashData = object.data();
+	entry->length = length;
+	memcpy_P(entry->data(), entry->flashData, length);
+	pushFront(entry);
+	maxLength = std::max(maxLength, length);
+	usedBytes += size;
+	++entryCount;
+	return entry->data();
+}
+
+bool RamCache::evict(size_t required)
+{
+	while(usedBytes + required > budget) {
+		if(tail == nullptr) {
+			return false;
+		}
+		release(tail);
+	}
+	return true;
+}
+
+void RamCache::pushFront(Entry* entry)
+{
+	entry->prev = nullptr;
+	entry->next = head;
+	if(head == nullptr) {
+		tail = entry;
+	} else {
+		head->prev = entry;
+	}
+	head = entry;
+}
+
+void RamCache::unlink(Entry* entry)
+{
+	if(entry->prev == nullptr) {
+		head = entry->next;
+	} else {
+		entry->prev->next = entry->next;
+	}
+	if(entry->next == nullptr) {
+		tail = entry->prev;
+	} else {
+		entry->next->prev = entry->prev;
+	}
+}
+
+void RamCache::release(Entry* entry)
+{
+	unlink(entry);
+	usedBytes -= entrySize(entry->length);
+	if(--entryCount == 0) {
+		maxLength = 0;
+	}
+	free(entry);
+}
+
+} // namespace FSTR
@@ -0,0 +1,81 @@
+/**
+ * Slice.cpp
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#include "include/FlashString/Slice.hpp"
+#include "include/FlashString/StringPrinter.hpp"
+#include "include/FlashString/Utility.hpp"
+
+namespace FSTR
+{
+bool Slice::equals(const char* data, size_t length) const
+{
+	Stats::Measure measure(*object_, Stats::Event::equals);
+	if(data == nullptr) {
+		return length_ == 0;
+	}
+	if(length == 0) {
+		length = strlen(data);
+	}
+	if(length != length_) {
+		return false;
+	}
+	measure.setBytes(length);
+	return compareFlash(this->data(), data, length) == 0;
+}
+
+bool Slice::equals(const Slice& other) const
+{
+	if(length_ != other.length_) {
+		return false;
+	}
+	auto otherData = other.data();
+	if(data() == otherData) {
+		return true;
+	}
+
+	Stats::Measure measure(*object_, Stats::Event::equals);
+	measure.setBytes(length_);
+	// Slices need not be word-aligned so compare in chunks
+	uint8_t buffer[compareChunkSize];
+	for(size_t offset = 0; offset < length_; offset += sizeof(buffer)) {
+		auto count = std::min(length_ - offset, sizeof(buffer));
+		memcpy_P(buffer, otherData + offset, count);
+		if(compareFlash(data() + offset, buffer, count) != 0) {
+			return false;
+		}
+	}
+	return true;
+}
+
+StringPrinter Slice::printer() const
+{
+	return StringPrinter(*this);
+}
+
+StringPrinter Slice::printer(char* buffer, size_t bufferSize) const
+{
+	return StringPrinter(*this, buffer, bufferSize);
+}
+
+size_t Slice::printTo(Print& p) const
+{
+	return printer().printTo(p);
+}
+
+} // namespace FSTR
@@ -0,0 +1,174 @@
+/**
+ * Stats.cpp
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#include "include/FlashString/Stats.hpp"
+
+#if FSTR_STATS
+
+#include "include/FlashString/ObjectBase.hpp"
+#include <Print.h>
+#include <esp_systemapi.h>
+
+namespace FSTR
+{
+namespace Stats
+{
+namespace
+{
+constexpr unsigned maxEntries = FSTR_STATS_MAX_OBJECTS;
+Entry entries[maxEntries];
+unsigned entryCount;
+unsigned droppedCount;
+
+/*
+ * Find entry for object using open addressing.
+ * If not found, returns the empty slot where it should go, or nullptr if the table is full.
+ */
+Entry* lookup(const void* data)
+{
+	auto index = (uintptr_t(data) >> 2) % maxEntries;
+	for(unsigned i = 0; i < maxEntries; ++i) {
+		auto& entry = entries[index];
+		if(entry.data == data || entry.data == nullptr) {
+			return &entry;
+		}
+		index = (index + 1) % maxEntries;
+	}
+	return nullptr;
+}
+
+const char* eventName(Event event)
+{
+	switch(event) {
+	case Event::read:
+		return "read";
+	case Event::readFlash:
+		return "readFlash";
+	case Event::stream:
+		return "stream";
+	case Event::lookup:
+		return "lookup";
+	case Event::equals:
+		return "equals";
+	default:
+		return "?";
+	}
+}
+
+} // namespace
+
+uint32_t clock()
+{
+	return esp_get_ccount();
+}
+
+void record(const ObjectBase& object, Event event, size_t bytes, uint32_t cycles, unsigned probes)
+{
+	auto data = object.data();
+	auto entry = lookup(data);
+	if(entry == nullptr) {
+		++droppedCount;
+		return;
+	}
+	if(entry->data == nullptr) {
+		entry->data = data;
+		entry->length = object.length();
+		++entryCount;
+	}
+
+	auto& counter = entry->counters[unsigned(event)];
+	++counter.calls;
+	counter.bytes += bytes;
+	counter.cycles += cycles;
+	entry->probes += probes;
+}
+
+const Entry* find(const ObjectBase& object)
+{
+	auto entry = lookup(object.data());
+	return (entry == nullptr || entry->data == nullptr) ? nullptr : entry;
+}
+
+unsigned count()
+{
+	return entryCount;
+}
+
+unsigned dropped()
+{
+	return droppedCount;
+}
+
+void reset()
+{
+	memset(entries, 0, sizeof(entries));
+	entryCount = 0;
+	droppedCount = 0;
+}
+
+size_t printReport(Print& p, unsigned maxCount)
+{
+	size_t n = p.printf(_F("FlashString statistics: %u objects, %u accesses dropped\r\n"), entryCount, droppedCount);
+
+	// Selection sort by total cycles, highest first
+	bool printed[maxEntries]{};
+	for(unsigned k = 0; k < maxCount && k < entryCount; ++k) {
+		const Entry* best = nullptr;
+		unsigned bestIndex = 0;
+		uint32_t bestCycles = 0;
+		for(unsigned i = 0; i < maxEntries; ++i) {
+			auto& entry = entries[i];
+			if(entry.data == nullptr || printed[i]) {
+				continue;
+			}
+			auto cycles = entry.total().cycles;
+			if(best == nullptr || cycles > bestCycles) {
+				best = &entry;
+				bestIndex = i;
+				bestCycles = cycles;
+			}
+		}
+		if(best == nullptr) {
+			break;
+		}
+		printed[bestIndex] = true;
+
+		n += p.printf(_F("  %p, %u bytes, %u cycles:"), best->data, unsigned(best->length), unsigned(bestCycles));
+		for(unsigned e = 0; e < unsigned(Event::MAX); ++e) {
+			auto& c = best->counters[e];
+			if(c.calls == 0) {
+				continue;
+			}
+			n += p.printf(_F(" %s %u (%u bytes"), eventName(Event(e)), unsigned(c.calls), unsigned(c.bytes));
+			if(Event(e) == Event::lookup) {
+				n += p.printf(_F(", %u probes"), unsigned(best->probes));
+			}
+			n += p.print(')');
+		}
+		n += p.println();
+	}
+
+	return n;
+}
+
+} // namespace Stats
+
+} // namespace FSTR
+
+#endif // FSTR_STATS
@@ -25,11 +25,10 @@ namespace FSTR
 {
 uint16_t Stream::readMemoryBlock(char* data, int bufSize)
 {
-	if(flashread) {
-		return object.readFlash(readPos, data, bufSize);
-	} else {
-		return object.read(readPos, data, bufSize);
-	}
+	Stats::Measure measure(slice.object(), Stats::Event::stream);
+	auto count = pread(readPos, data, bufSize);
+	measure.setBytes(count);
+	return count;
 }
 
 int Stream::seekFrom(int offset, SeekOrigin origin)
@@ -43,13 +42,13 @@ int Stream::seekFrom(int offset, SeekOrigin origin)
 		newPos = readPos + offset;
 		break;
 	case SeekOrigin::End:
-		newPos = object.length() + offset;
+		newPos = slice.length() + offset;
 		break;
 	default:
 		return -1;
 	}
 
-	if(newPos > object.length()) {
+	if(newPos > slice.length()) {
 		return -1;
 	}
 
@@ -20,11 +20,34 @@
 #include "include/FlashString/String.hpp"
 #include <WString.h>
 #include <esp_spi_flash.h>
+#include <stringutil.h>
 
 namespace FSTR
 {
+static_assert(FSTR_POOL_LENGTH_FLAGS == ObjectBase::typedLength(0, Type::string, 1), "FSTR_POOL_LENGTH_FLAGS incorrect");
+
+namespace
+{
+/*
+ * Compare object content with data in RAM, using a copy held by the active RamCache if there is one
+ */
+int compareContent(const ObjectBase& object, size_t offset, const void* data, size_t length, bool ignoreCase = false)
+{
+#if FSTR_RAM_CACHE
+	auto cached = object.cachedData();
+	if(cached != nullptr) {
+		cached += offset;
+		return ignoreCase ? memicmp(cached, data, length) : memcmp(cached, data, length);
+	}
+#endif
+	return compareFlash(object.data() + offset, data, length, ignoreCase);
+}
+
+} // namespace
+
 bool String::equals(const char* cstr, size_t len) const
 {
+	Stats::Measure measure(*this, Stats::Event::equals);
 	// Unlikely we'd want an empty flash string, but check anyway
 	if(cstr == nullptr) {
 		return length() == 0;
@@ -36,21 +59,138 @@ bool String::equals(const char* cstr, size_t len) const
 	if(len != length()) {
 		return false;
 	}
-	LOAD_FSTR(buf, *this);
-	return memcmp(buf, cstr, len) == 0;
+	measure.setBytes(len);
+	return compareContent(*this, 0, cstr, len) == 0;
 }
 
 bool String::equals(const String& str) const
 {
+	Stats::Measure measure(*this, Stats::Event::equals);
 	if(data() == str.data()) {
 		return true;
 	}
 	if(length() != str.length()) {
 		return false;
 	}
+	if(hasHash() && !str.matchesHash(storedHash())) {
+		return false;
+	}
+	measure.setBytes(length());
+#if FSTR_RAM_CACHE
+	auto cached = str.cachedData();
+	if(cached != nullptr) {
+		return compareContent(*this, 0, cached, length()) == 0;
+	}
+	cached = cachedData();
+	if(cached != nullptr) {
+		return compareFlash(str.data(), cached, length()) == 0;
+	}
+#endif
 	return memcmp_aligned(data(), str.data(), length()) == 0;
 }
 
+bool String::equalsIgnoreCase(const char* cstr, size_t len) const
+{
+	if(cstr == nullptr) {
+		return length() == 0;
+	}
+	if(len == 0) {
+		len = strlen(cstr);
+	}
+	if(len != length()) {
+		return false;
+	}
+	return compareContent(*this, 0, cstr, len, true) == 0;
+}
+
+bool String::equalsIgnoreCase(const String& str) const
+{
+	if(length() != str.length()) {
+		return false;
+	}
+	if(hasHash() && !str.matchesHash(storedHash())) {
+		return false;
+	}
+	return compare(str, true) == 0;
+}
+
+int String::compare(const char* cstr, size_t len, bool ignoreCase) const
+{
+	auto flen = length();
+	auto n = std::min(flen, len);
+	int res = compareContent(*this, 0, cstr, n, ignoreCase);
+	if(res != 0) {
+		return res;
+	}
+	return (flen < len) ? -1 : (flen > len) ? 1 : 0;
+}
+
+int String::compare(const String& str, bool ignoreCase) const
+{
+	if(data() == str.data()) {
+		return 0;
+	}
+
+	// Both Strings are in flash, so read the other one in chunks
+	char buf[compareChunkSize] FSTR_ALIGNED;
+	auto flen = length();
+	size_t offset = 0;
+	size_t count;
+	while(offset < flen && (count = str.read(offset, buf, std::min(flen - offset, sizeof(buf)))) != 0) {
+		int res = compareContent(*this, offset, buf, count, ignoreCase);
+		if(res != 0) {
+			return res;
+		}
+		offset += count;
+	}
+
+	auto len = str.length();
+	return (flen < len) ? -1 : (flen > len) ? 1 : 0;
+}
+
+bool String::startsWith(const char* prefix, size_t len) const
+{
+	if(prefix == nullptr) {
+		return true;
+	}
+	if(len == 0) {
+		len = strlen(prefix);
+	}
+	return len <= length() && compareContent(*this, 0, prefix, len) == 0;
+}
+
+bool String::endsWith(const char* suffix, size_t len) const
+{
+	if(suffix == nullptr) {
+		return true;
+	}
+	if(len == 0) {
+		len = strlen(suffix);
+	}
+	auto flen = length();
+	if(len > flen) {
+		return false;
+	}
+	return compareContent(*this, flen - len, suffix, len) == 0;
+}
+
+uint32_t String::hash() const
+{
+	if(hasHash()) {
+		return storedHash();
+	}
+
+	char buf[compareChunkSize] FSTR_ALIGNED;
+	uint32_t value = Hash::offsetBasis;
+	size_t offset = 0;
+	size_t count;
+	while((count = read(offset, buf, sizeof(buf))) != 0) {
+		value = Hash::update(value, buf, count);
+		offset += count;
+	}
+	return value;
+}
+
 /* Wiring String support */
 
 String::operator WString() const
@@ -64,9 +204,7 @@ bool String::equals(const WString& str) const
 	if(len != length()) {
 		return false;
 	}
-	// @todo optimise memcmp_P then we won't need to load entire String into RAM first
-	LOAD_FSTR(buf, *this);
-	return memcmp(buf, str.c_str(), len) == 0;
+	return compareContent(*this, 0, str.c_str(), len) == 0;
 }
 
 bool String::equalsIgnoreCase(const WString& str) const
@@ -75,8 +213,34 @@ bool String::equalsIgnoreCase(const WString& str) const
 	if(len != length()) {
 		return false;
 	}
-	LOAD_FSTR(buf, *this);
-	return memicmp(buf, str.c_str(), len) == 0;
+	return compareContent(*this, 0, str.c_str(), len, true) == 0;
+}
+
+int String::compare(const WString& str, bool ignoreCase) const
+{
+	return compare(str.c_str(), str.length(), ignoreCase);
+}
+
+int String::indexOf(const WString& str, size_t fromIndex) const
+{
+	return searchFlash(data(), length(), str.c_str(), str.length(), fromIndex);
+}
+
+bool String::startsWith(const WString& prefix) const
+{
+	auto len = prefix.length();
+	return len == 0 || startsWith(prefix.c_str(), len);
+}
+
+bool String::endsWith(const WString& suffix) const
+{
+	auto len = suffix.length();
+	return len == 0 || endsWith(suffix.c_str(), len);
+}
+
+uint32_t Hash::calculate(const WString& str)
+{
+	return calculate(str.c_str(), str.length());
 }
 
 } // namespace FSTR
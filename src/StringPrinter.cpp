@@ -18,25 +18,30 @@
  ****/
 
 #include "include/FlashString/StringPrinter.hpp"
-#include "include/FlashString/String.hpp"
 #include <Print.h>
 
 namespace FSTR
 {
 size_t StringPrinter::printTo(Print& p) const
 {
-	// Print in chunks
-	char buffer[256];
+	if(buffer != nullptr && bufferSize != 0) {
+		return printChunks(p, buffer, bufferSize);
+	}
+
+	char buf[FSTR_PRINT_CHUNK_SIZE];
+	return printChunks(p, buf, sizeof(buf));
+}
+
+size_t StringPrinter::printChunks(Print& p, char* buf, size_t bufSize) const
+{
+	// For small Strings, read via cache
+	bool useCache = slice.length() <= cacheThreshold;
+
 	size_t offset = 0;
 	size_t totalWriteCount = 0;
 	size_t readCount;
-	// For small Strings, read via cache
-	if(string.length() <= 64) {
-		readCount = string.read(0, buffer, sizeof(buffer));
-		return p.write(buffer, readCount);
-	}
-	while((readCount = string.readFlash(offset, buffer, sizeof(buffer))) > 0) {
-		auto writeCount = p.write(buffer, readCount);
+	while((readCount = useCache ? slice.read(offset, buf, bufSize) : slice.readFlash(offset, buf, bufSize)) > 0) {
+		auto writeCount = p.write(buf, readCount);
 		totalWriteCount += writeCount;
 		if(writeCount != readCount) {
 			break;
@@ -0,0 +1,156 @@
+/**
+ * Utility.cpp
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#include "include/FlashString/Utility.hpp"
+#include <stringutil.h>
+
+namespace FSTR
+{
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "SWAR search requires little-endian byte order");
+
+namespace
+{
+/*
+ * Return word with top bit set in each zero byte, and no others.
+ * Unlike the shorter `(v - 0x01010101) & ~v & 0x80808080` there is no carry between bytes,
+ * so any byte mask may be applied to the result.
+ */
+FSTR_INLINE uint32_t zeroBytes(uint32_t v)
+{
+	return ~(((v & 0x7f7f7f7fU) + 0x7f7f7f7fU) | v | 0x7f7f7f7fU);
+}
+
+FSTR_INLINE uint32_t zeroHalfWords(uint32_t v)
+{
+	return ~(((v & 0x7fff7fffU) + 0x7fff7fffU) | v | 0x7fff7fffU);
+}
+
+// Mask covering the first n bytes of a word
+FSTR_INLINE uint32_t byteMask(unsigned n)
+{
+	return (n >= 4) ? 0xffffffffU : (1U << (n * 8)) - 1;
+}
+
+} // namespace
+
+int compareFlash(const void* flashData, const void* data, size_t length, bool ignoreCase)
+{
+	auto flashPtr = static_cast<const uint8_t*>(flashData);
+	auto ramPtr = static_cast<const uint8_t*>(data);
+	bool aligned = IS_ALIGNED(flashPtr);
+	uint8_t buffer[compareChunkSize] FSTR_ALIGNED;
+	while(length != 0) {
+		auto count = std::min(length, compareChunkSize);
+		if(aligned) {
+			memcpy_aligned(buffer, flashPtr, count);
+		} else {
+			memcpy_P(buffer, flashPtr, count);
+		}
+		int res = ignoreCase ? memicmp(buffer, ramPtr, count) : memcmp(buffer, ramPtr, count);
+		if(res != 0) {
+			return res;
+		}
+		flashPtr += count;
+		ramPtr += count;
+		length -= count;
+	}
+
+	return 0;
+}
+
+int findFlash(const void* flashData, size_t length, uint8_t c, size_t offset)
+{
+	if(offset >= length) {
+		return -1;
+	}
+
+	auto wordPtr = static_cast<const uint32_t*>(flashData) + (offset / 4);
+	const uint32_t pattern = 0x01010101U * c;
+	size_t pos = offset & ~3U;
+	// Ignore leading bytes in first word
+	uint32_t mask = ~byteMask(offset & 3);
+	for(;;) {
+		if(length - pos < 4) {
+			mask &= byteMask(length - pos);
+		}
+		uint32_t match = zeroBytes(pgm_read_dword(wordPtr) ^ pattern) & mask;
+		if(match != 0) {
+			return pos + (__builtin_ctz(match) / 8);
+		}
+		pos += 4;
+		if(pos >= length) {
+			return -1;
+		}
+		++wordPtr;
+		mask = 0xffffffffU;
+	}
+}
+
+int findFlash16(const void* flashData, size_t count, uint16_t value, size_t index)
+{
+	if(index >= count) {
+		return -1;
+	}
+
+	auto wordPtr = static_cast<const uint32_t*>(flashData) + (index / 2);
+	const uint32_t pattern = 0x00010001U * value;
+	size_t pos = index & ~1U;
+	uint32_t mask = (index & 1) ? 0xffff0000U : 0xffffffffU;
+	for(;;) {
+		if(count - pos < 2) {
+			mask &= 0x0000ffffU;
+		}
+		uint32_t match = zeroHalfWords(pgm_read_dword(wordPtr) ^ pattern) & mask;
+		if(match != 0) {
+			return pos + (__builtin_ctz(match) / 16);
+		}
+		pos += 2;
+		if(pos >= count) {
+			return -1;
+		}
+		++wordPtr;
+		mask = 0xffffffffU;
+	}
+}
+
+int searchFlash(const void* flashData, size_t length, const void* data, size_t dataLength, size_t offset)
+{
+	if(offset > length || dataLength > length - offset) {
+		return -1;
+	}
+	if(dataLength == 0) {
+		return offset;
+	}
+
+	auto bytes = static_cast<const uint8_t*>(data);
+	auto flashPtr = static_cast<const uint8_t*>(flashData);
+	// No match possible beyond this point
+	auto searchLength = length - dataLength + 1;
+	int pos;
+	while((pos = findFlash(flashData, searchLength, bytes[0], offset)) >= 0) {
+		if(compareFlash(flashPtr + pos + 1, bytes + 1, dataLength - 1) == 0) {
+			return pos;
+		}
+		offset = pos + 1;
+	}
+
+	return -1;
+}
+
+} // namespace FSTR
@@ -0,0 +1,320 @@
+/**
+ * Variant.cpp
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#include "include/FlashString/Variant.hpp"
+#include "include/FlashString/ArrayPrinter.hpp"
+
+namespace FSTR
+{
+namespace
+{
+/*
+ * Map entries are laid out as for MapPair: the key, followed by a pointer to the content
+ */
+constexpr size_t mapContentOffset(size_t keySize)
+{
+	return (keySize + sizeof(void*) - 1) & ~(sizeof(void*) - 1);
+}
+
+/*
+ * Get the type of numeric values in an Array, or keys in a Map
+ */
+Type numericType(Type type)
+{
+	switch(type) {
+	case Type::character:
+	case Type::signedMap:
+		return Type::signedInt;
+	case Type::unsignedMap:
+		return Type::unsignedInt;
+	case Type::floatMap:
+		return Type::floatingPoint;
+	default:
+		return type;
+	}
+}
+
+template <typename T> T readNumber(const uint8_t* ptr)
+{
+	T value;
+	memcpy_P(&value, ptr, sizeof(T));
+	return value;
+}
+
+size_t printInt(Print& p, int64_t value)
+{
+	if(value >= INT32_MIN && value <= INT32_MAX) {
+		return p.print(long(value));
+	}
+
+	// Print doesn't support 64-bit values
+	char buf[24];
+	char* s = &buf[sizeof(buf)];
+	auto n = (value < 0) ? 0 - uint64_t(value) : uint64_t(value);
+	do {
+		*--s = '0' + (n % 10);
+		n /= 10;
+	} while(n != 0);
+	if(value < 0) {
+		*--s = '-';
+	}
+	return p.write(s, &buf[sizeof(buf)] - s);
+}
+
+} // namespace
+
+size_t Variant::elementSize() const
+{
+	if(!*this) {
+		return 0;
+	}
+
+	auto size = object->storedElementSize();
+	return (size == 0) ? 1 : size;
+}
+
+size_t Variant::stride() const
+{
+	return isMap() ? mapContentOffset(elementSize()) + sizeof(void*) : elementSize();
+}
+
+size_t Variant::length() const
+{
+	auto size = stride();
+	return (size == 0) ? 0 : object->length() / size;
+}
+
+const uint8_t* Variant::elementPtr(unsigned index) const
+{
+	if(index >= length()) {
+		return nullptr;
+	}
+
+	return object->data() + index * stride();
+}
+
+const ObjectBase* Variant::readPointer(unsigned index, size_t offset) const
+{
+	auto ptr = elementPtr(index);
+	if(ptr == nullptr) {
+		return nullptr;
+	}
+
+	return readNumber<const ObjectBase*>(ptr + offset);
+}
+
+int64_t Variant::getInt(unsigned index) const
+{
+	if(!isArray() && !isMap()) {
+		return 0;
+	}
+
+	auto ptr = elementPtr(index);
+	if(ptr == nullptr) {
+		return 0;
+	}
+
+	auto type = numericType(this->type());
+	auto size = elementSize();
+	if(type == Type::signedInt) {
+		switch(size) {
+		case 1:
+			return readNumber<int8_t>(ptr);
+		case 2:
+			return readNumber<int16_t>(ptr);
+		case 4:
+			return readNumber<int32_t>(ptr);
+		case 8:
+			return readNumber<int64_t>(ptr);
+		}
+	} else if(type == Type::unsignedInt) {
+		switch(size) {
+		case 1:
+			return readNumber<uint8_t>(ptr);
+		case 2:
+			return readNumber<uint16_t>(ptr);
+		case 4:
+			return readNumber<uint32_t>(ptr);
+		case 8:
+			return readNumber<uint64_t>(ptr);
+		}
+	} else if(type == Type::floatingPoint) {
+		return getFloat(index);
+	}
+
+	return 0;
+}
+
+double Variant::getFloat(unsigned index) const
+{
+	if(numericType(type()) != Type::floatingPoint) {
+		return getInt(index);
+	}
+
+	auto ptr = elementPtr(index);
+	if(ptr == nullptr) {
+		return 0;
+	}
+
+	switch(elementSize()) {
+	case sizeof(float):
+		return readNumber<float>(ptr);
+	case sizeof(double):
+		return readNumber<double>(ptr);
+	default:
+		return 0;
+	}
+}
+
+const String& Variant::asString() const
+{
+	return isString() ? object->as<String>() : String::empty();
+}
+
+Variant Variant::valueAt(unsigned index) const
+{
+	if(isVector()) {
+		return readPointer(index, 0);
+	}
+
+	if(isMap()) {
+		return readPointer(index, mapContentOffset(elementSize()));
+	}
+
+	return Variant();
+}
+
+Variant Variant::keyAt(unsigned index) const
+{
+	return (type() == Type::stringMap) ? readPointer(index, 0) : nullptr;
+}
+
+int Variant::indexOf(const char* key, bool ignoreCase) const
+{
+	if(type() != Type::stringMap || key == nullptr) {
+		return -1;
+	}
+
+	auto keyLength = strlen(key);
+	Hash::LazyKey<const char*> keyHash(key);
+	auto len = length();
+	for(unsigned i = 0; i < len; ++i) {
+		auto k = readPointer(i, 0);
+		if(k == nullptr) {
+			continue;
+		}
+		auto& s = k->as<String>();
+		if(!keyHash.mayMatch(s)) {
+			continue;
+		}
+		if(ignoreCase ? s.equalsIgnoreCase(key, keyLength) : s.equals(key, keyLength)) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+int Variant::indexOf(int64_t key) const
+{
+	auto type = this->type();
+	if(type != Type::signedMap && type != Type::unsignedMap && type != Type::floatMap) {
+		return -1;
+	}
+
+	auto len = length();
+	for(unsigned i = 0; i < len; ++i) {
+		if((type == Type::floatMap) ? (getFloat(i) == key) : (getInt(i) == key)) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+size_t Variant::printElement(Print& p, unsigned index) const
+{
+	switch(numericType(type())) {
+	case Type::signedInt:
+		if(type() == Type::character) {
+			return FSTR::printElement(p, char(getInt(index)));
+		}
+		// fall-through
+	case Type::unsignedInt:
+		return printInt(p, getInt(index));
+	case Type::floatingPoint:
+		return p.print(getFloat(index));
+	default:
+		// Structures
+		return p.print("(struct)");
+	}
+}
+
+size_t Variant::print(Print& p) const
+{
+	if(!*this) {
+		return 0;
+	}
+
+	if(!isArray() && !isVector() && !isMap()) {
+		// Strings and untyped objects
+		return object->as<String>().printTo(p);
+	}
+
+	size_t count = 0;
+	auto map = isMap();
+	auto len = length();
+	// Same as MapPrinter, an empty map is "{\r\n}"
+	count += p.print(map ? ((len == 0) ? "{\r\n" : "{\r\n  ") : "{");
+	for(unsigned i = 0; i < len; ++i) {
+		if(i > 0) {
+			count += p.print(map ? "\r\n  " : ", ");
+		}
+		if(isVector()) {
+			count += valueAt(i).print(p);
+		} else if(map) {
+			if(type() == Type::stringMap) {
+				count += keyAt(i).print(p);
+			} else {
+				count += printElement(p, i);
+			}
+			count += p.print(" => ");
+			count += valueAt(i).print(p);
+		} else {
+			count += printElement(p, i);
+		}
+	}
+	count += p.print((map && len != 0) ? "\r\n}" : "}");
+
+	return count;
+}
+
+size_t Variant::printTo(Print& p) const
+{
+	BufferedPrint<FSTR_PRINT_BUFFER_SIZE> out(p);
+	print(out);
+	return out.flush();
+}
+
+size_t ObjectBase::printTo(Print& p) const
+{
+	return Variant(*this).printTo(p);
+}
+
+} // namespace FSTR
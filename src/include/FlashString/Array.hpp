@@ -23,6 +23,7 @@
 
 #include "Object.hpp"
 #include "ArrayPrinter.hpp"
+#include <algorithm>
 
 /**
  * @defgroup fstr_array Arrays
@@ -66,7 +67,9 @@
 	constexpr const struct {                                                                                           \
 		FSTR::ObjectBase object;                                                                                       \
 		ElementType data[sizeof((const ElementType[]){__VA_ARGS__}) / sizeof(ElementType)];                            \
-	} FSTR_PACKED FSTR_ALIGNED name PROGMEM = {{sizeof(name.data)}, {__VA_ARGS__}};                                    \
+	} FSTR_PACKED FSTR_ALIGNED name PROGMEM = {                                                                        \
+		{FSTR::ObjectBase::typedLength(sizeof(name.data), FSTR::arrayType<ElementType>(), sizeof(ElementType))},       \
+		{__VA_ARGS__}};                                                                                                \
 	FSTR_CHECK_STRUCT(name);
 
 /**
@@ -113,21 +116,131 @@ namespace FSTR
 template <typename ElementType> class Array : public Object<Array<ElementType>, ElementType>
 {
 public:
+	/* Searching sorted arrays */
+
+	/**
+	 * @brief Find first element which is not less than the given value
+	 * @param value
+	 * @param compare Comparison function, `bool compare(const ElementType& element, const ValueType& value)`
+	 * @retval unsigned Index of element, or length() if there is none
+	 * @note Array must be sorted (partitioned) with respect to the comparison.
+	 * Requires O(log n) element reads, compared with O(n) for `indexOf()`.
+	 */
+	template <typename ValueType, typename Compare>
+	unsigned lowerBound(const ValueType& value, Compare compare) const
+	{
+		return std::lower_bound(this->begin(), this->end(), value, compare).getIndex();
+	}
+
+	template <typename ValueType> unsigned lowerBound(const ValueType& value) const
+	{
+		return lowerBound(value, [](const ElementType& e, const ValueType& v) { return e < v; });
+	}
+
+	/**
+	 * @brief Find first element which is greater than the given value
+	 * @param value
+	 * @param compare Comparison function, `bool compare(const ValueType& value, const ElementType& element)`
+	 * @retval unsigned Index of element, or length() if there is none
+	 */
+	template <typename ValueType, typename Compare>
+	unsigned upperBound(const ValueType& value, Compare compare) const
+	{
+		return std::upper_bound(this->begin(), this->end(), value, compare).getIndex();
+	}
+
+	template <typename ValueType> unsigned upperBound(const ValueType& value) const
+	{
+		return upperBound(value, [](const ValueType& v, const ElementType& e) { return v < e; });
+	}
+
+	/**
+	 * @brief Find range of elements equal to the given value
+	 * @param value
+	 * @retval std::pair<unsigned, unsigned> Indices as for `lowerBound()` and `upperBound()`.
+	 * The range is empty if the value is not present.
+	 */
+	template <typename ValueType> std::pair<unsigned, unsigned> equalRange(const ValueType& value) const
+	{
+		auto first = lowerBound(value);
+		auto len = this->length();
+		if(first == len || value < this->valueAt(first)) {
+			return std::make_pair(first, first);
+		}
+		// Remaining search is limited to the upper part of the array
+		auto it = std::upper_bound(this->begin() + first, this->end(), value,
+								   [](const ValueType& v, const ElementType& e) { return v < e; });
+		return std::make_pair(first, it.getIndex());
+	}
+
+	/**
+	 * @brief Find index of a value using binary search
+	 * @param value
+	 * @retval int Index of first matching element, or -1 if not found
+	 * @note Array must be sorted in ascending order
+	 */
+	template <typename ValueType> int indexOfSorted(const ValueType& value) const
+	{
+		auto index = lowerBound(value);
+		return (index < this->length() && !(value < this->valueAt(index))) ? int(index) : -1;
+	}
+
+	/**
+	 * @brief Use this array as the x-axis of a curve, interpolating a y-value
+	 * @param x Value to look up
+	 * @param yValues Corresponding y values, must be the same length as this array
+	 * @retval double Linearly interpolated y value
+	 *
+	 * This array must be sorted in ascending order. Values outside the range are clamped
+	 * to the first or last y value. Typical use is applying a calibration curve:
+	 *
+	 * 		DEFINE_FSTR_ARRAY(adcReading, int16_t, 0, 410, 1230, 4095);
+	 * 		DEFINE_FSTR_ARRAY(temperature, float, -40, 0, 50, 125);
+	 * 		...
+	 * 		float t = adcReading.interpolate(value, temperature);
+	 *
+	 * Requires O(log n) element reads.
+	 */
+	template <typename YType> double interpolate(double x, const Array<YType>& yValues) const
+	{
+		auto len = std::min(this->length(), yValues.length());
+		if(len == 0) {
+			return 0;
+		}
+		auto index = lowerBound(x, [](const ElementType& e, double v) { return e < v; });
+		if(index == 0) {
+			return yValues.valueAt(0);
+		}
+		if(index >= len) {
+			return yValues.valueAt(len - 1);
+		}
+		double x0 = this->valueAt(index - 1);
+		double x1 = this->valueAt(index);
+		double y0 = yValues.valueAt(index - 1);
+		double y1 = yValues.valueAt(index);
+		return y0 + (y1 - y0) * (x - x0) / (x1 - x0);
+	}
+
 	/* Arduino Print support */
 
 	/**
 	 * @brief Returns a printer object for this array
 	 * @note ElementType must be supported by Print
 	 */
-	ArrayPrinter<Array> printer() const
+	ArrayPrinter<Array> printer(const PrintFormat& format = PrintFormat()) const
 	{
-		return ArrayPrinter<Array>(*this);
+		return ArrayPrinter<Array>(*this, format);
 	}
 
 	size_t printTo(Print& p) const
 	{
 		return printer().printTo(p);
 	}
+
+	size_t printTo(Print& p, const PrintFormat& format) const
+	{
+		return printer(format).printTo(p);
+	}
 };
 
 } // namespace FSTR
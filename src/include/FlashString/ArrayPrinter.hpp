@@ -81,35 +81,60 @@ template <typename T> typename std::enable_if<std::is_same<T, char>::value, size
 	return p.write(buf, o - buf);
 }
 
+/**
+ * @brief Print an element using a specific number base
+ * @note Applies only to integral types other than char and bool
+ */
+template <typename T>
+typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, char>::value && !std::is_same<T, bool>::value,
+						size_t>::type
+printElement(Print& p, T e, uint8_t base)
+{
+	return (base == DEC) ? printElement(p, e) : p.print(e, base);
+}
+
+template <typename T>
+typename std::enable_if<!std::is_integral<T>::value || std::is_same<T, char>::value || std::is_same<T, bool>::value,
+						size_t>::type
+printElement(Print& p, T e, uint8_t)
+{
+	return printElement(p, e);
+}
+
 /**
  * @brief Class template to provide a simple way to print the contents of an array
  * @note Used by Array::printTo() method
+ *
+ * Output is collected in a stack buffer of FSTR_PRINT_BUFFER_SIZE bytes and written in blocks.
  */
 template <class ArrayType> class ArrayPrinter : public Printable
 {
 public:
-	ArrayPrinter(const ArrayType& array) : array(array)
+	ArrayPrinter(const ArrayType& array, const PrintFormat& format = PrintFormat()) : array(array), format(format)
 	{
 	}
 
 	size_t printTo(Print& p) const override
 	{
-		size_t count = 0;
+		BufferedPrint<FSTR_PRINT_BUFFER_SIZE> out(p);
 
-		count += p.print('{');
-		for(unsigned i = 0; i < array.length(); ++i) {
+		out.print(format.prefix ? format.prefix : "{");
+		auto separator = format.separator ? format.separator : ", ";
+		auto len = array.length();
+		for(unsigned i = 0; i < len; ++i) {
 			if(i > 0) {
-				count += p.print(", ");
+				out.print(separator);
 			}
-			count += printElement(p, array[i]);
+			printElement(out, array[i], format.base);
 		}
-		count += p.print('}');
+		out.print(format.suffix ? format.suffix : "}");
 
-		return count;
+		return out.flush();
 	}
 
 private:
 	const ArrayType& array;
+	PrintFormat format;
 };
 
 } // namespace FSTR
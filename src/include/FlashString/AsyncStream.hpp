@@ -0,0 +1,124 @@
+/****
+ * AsyncStream.hpp - Double-buffered stream with background prefetch
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#pragma once
+
+#include "ObjectBase.hpp"
+#include <Data/Stream/DataSourceStream.h>
+
+namespace FSTR
+{
+/**
+ * @brief Stream which reads the next block of flash content in the background
+ * @ingroup fstr_stream
+ *
+ * Content is read using `flashmem_read()` into one of two RAM buffers of `FSTR_ASYNC_BLOCK_SIZE` bytes.
+ * While data from one buffer is being consumed, the next block is read into the other buffer
+ * from the system task queue. Each task reads a single block, so other tasks get to run between blocks.
+ *
+ * All AsyncStream instances share one prefetch queue, serviced in turn, so several large downloads
+ * proceed at the same rate without any one of them holding up the event loop.
+ *
+ * If data is requested before it has been prefetched then it is read immediately.
+ */
+class AsyncStream : public IDataSourceStream
+{
+public:
+	static constexpr size_t blockSize = FSTR_ASYNC_BLOCK_SIZE;
+
+	AsyncStream(const ObjectBase& object) : object(object)
+	{
+		requestPrefetch();
+	}
+
+	~AsyncStream()
+	{
+		cancelPrefetch();
+	}
+
+	// Holds pointers into its own buffers and links in the prefetch queue
+	AsyncStream(const AsyncStream&) = delete;
+	AsyncStream& operator=(const AsyncStream&) = delete;
+
+	StreamType getStreamType() const override
+	{
+		return eSST_Memory;
+	}
+
+	int available() override
+	{
+		return object.length() - readPos;
+	}
+
+	uint16_t readMemoryBlock(char* data, int bufSize) override;
+
+	int seekFrom(int offset, SeekOrigin origin) override;
+
+	bool isFinished() override
+	{
+		return readPos >= object.length();
+	}
+
+	/**
+	 * @brief Determine whether data at the current position can be read without blocking
+	 */
+	bool isReady() const
+	{
+		return findBlock(blockStart(readPos)) != nullptr;
+	}
+
+	/**
+	 * @brief Perform a single prefetch for the next stream in the queue
+	 * @retval bool true if more prefetches are pending
+	 * @note Called automatically from the task queue
+	 */
+	static bool service();
+
+private:
+	struct Block {
+		size_t offset;
+		uint16_t length;
+		bool ready;
+		char data[blockSize];
+	};
+
+	static size_t blockStart(size_t pos)
+	{
+		return pos - (pos % blockSize);
+	}
+
+	const Block* findBlock(size_t offset) const;
+	Block& loadBlock(size_t offset);
+	void requestPrefetch();
+	void cancelPrefetch();
+	void readBlock(Block& block);
+	static void taskCallback(void* param);
+
+	const ObjectBase& object;
+	size_t readPos = 0;
+	Block blocks[2]{};
+	Block* pendingBlock = nullptr; ///< Block awaiting prefetch
+	AsyncStream* next = nullptr;   ///< Next stream in prefetch queue
+
+	static AsyncStream* queueHead;
+	static AsyncStream* queueTail;
+	static bool taskQueued;
+};
+
+} // namespace FSTR
@@ -0,0 +1,159 @@
+/****
+ * CachedReader.hpp - Random-access reader with a RAM block cache
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#pragma once
+
+#include "Object.hpp"
+
+namespace FSTR
+{
+/**
+ * @brief Provides cached access to the elements of a large object
+ * @ingroup fstr_object
+ * @tparam ObjectType Type of object to read, such as `Array<uint16_t>`
+ * @tparam BlockSize Size of RAM cache in bytes
+ *
+ * Reading elements using `Object::valueAt()` goes via the CPU data cache, which can degrade
+ * performance for other code when the object is large. Instead, this class reads a block of
+ * elements at a time into RAM using `Object::readFlash()`, which bypasses the cache.
+ * Accesses to neighbouring elements are then served from RAM.
+ *
+ * Example:
+ *
+ * 		IMPORT_FSTR_ARRAY(samples, uint16_t, PROJECT_DIR "/files/samples.bin");
+ * 		...
+ * 		FSTR::CachedReader<FSTR::Array<uint16_t>, 256> reader(samples);
+ * 		uint32_t sum = 0;
+ * 		for(auto v : reader) {
+ * 			sum += v;
+ * 		}
+ *
+ * @note Reading the cached block modifies internal state, so instances are not thread-safe.
+ * Use a `ConcurrentReader` to share an instance between tasks.
+ */
+template <class ObjectType, size_t BlockSize = 64> class CachedReader
+{
+public:
+	using ElementType = typename ObjectType::Iterator::value_type;
+	using Iterator = ObjectIterator<CachedReader, ElementType>;
+
+	static constexpr size_t blockElements = BlockSize / sizeof(ElementType);
+	static_assert(blockElements != 0, "CachedReader BlockSize too small for element");
+
+	CachedReader(const ObjectType& object) : object(object)
+	{
+	}
+
+	Iterator begin() const
+	{
+		return Iterator(*this, 0);
+	}
+
+	Iterator end() const
+	{
+		return Iterator(*this, length());
+	}
+
+	/**
+	 * @brief Get the object length in elements
+	 */
+	size_t length() const
+	{
+		return object.length();
+	}
+
+	/**
+	 * @brief Read an element, via the cache
+	 * @param index
+	 * @retval ElementType Default-constructed value if index is out of range
+	 */
+	ElementType valueAt(unsigned index) const
+	{
+		if(!loadBlock(index)) {
+			return ElementType{};
+		}
+
+		return cache[index - cacheIndex];
+	}
+
+	ElementType operator[](unsigned index) const
+	{
+		return valueAt(index);
+	}
+
+	/**
+	 * @brief Read elements into RAM, via the cache
+	 * @param index First element to read
+	 * @param buffer Where to store data
+	 * @param count How many elements to read
+	 * @retval size_t Number of elements actually read
+	 * @note Requests for a block or more are read directly from flash
+	 */
+	size_t read(size_t index, ElementType* buffer, size_t count) const
+	{
+		if(count >= blockElements) {
+			return object.readFlash(index, buffer, count);
+		}
+
+		size_t total = 0;
+		while(count != 0 && loadBlock(index)) {
+			auto offset = index - cacheIndex;
+			auto n = std::min(count, cacheCount - offset);
+			memcpy(buffer, &cache[offset], n * sizeof(ElementType));
+			buffer += n;
+			index += n;
+			count -= n;
+			total += n;
+		}
+
+		return total;
+	}
+
+	/**
+	 * @brief Get the underlying object
+	 */
+	const ObjectType& getObject() const
+	{
+		return object;
+	}
+
+private:
+	/*
+	 * Ensure block containing the given element is in the cache
+	 * Returns false if index is out of range
+	 */
+	bool loadBlock(unsigned index) const
+	{
+		if(index - cacheIndex < cacheCount) {
+			return true;
+		}
+
+		auto blockIndex = index - (index % blockElements);
+		cacheCount = object.readFlash(blockIndex, cache, blockElements);
+		cacheIndex = blockIndex;
+		return index - cacheIndex < cacheCount;
+	}
+
+	const ObjectType& object;
+	mutable ElementType cache[blockElements] FSTR_ALIGNED;
+	mutable size_t cacheIndex = 0;
+	mutable size_t cacheCount = 0;
+};
+
+} // namespace FSTR
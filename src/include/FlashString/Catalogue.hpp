@@ -0,0 +1,183 @@
+/****
+ * Catalogue.hpp - Optional register of all objects, for validation at startup
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#pragma once
+
+#include "config.hpp"
+
+class Print;
+
+/**
+ * @brief Linker section containing catalogue entries
+ * @note Name must be a valid C identifier so the linker provides `__start_` and `__stop_` symbols
+ */
+#define FSTR_CATALOGUE_SECTION "fstr_catalogue"
+
+#if FSTR_CATALOGUE
+
+/**
+ * @brief Add an object to the catalogue
+ * @param name Name of the object reference, used to name the entry
+ * @param object The actual object (not a reference or copy)
+ * @note Used by the IMPORT macros, and by FSTR_CATALOGUE_ADD
+ */
+#define FSTR_CATALOGUE_ENTRY(name, object)                                                                             \
+	static const FSTR::ObjectBase* const fstr_cat_##name __attribute__((used, section(FSTR_CATALOGUE_SECTION))) =      \
+		&object;
+
+#else
+
+#define FSTR_CATALOGUE_ENTRY(name, object)
+
+#endif
+
+/**
+ * @brief Add an object defined using one of the DEFINE macros to the catalogue
+ * @param name Name of the object reference
+ * @ingroup fstr_object
+ * @note Must be used at file scope, in the same translation unit as the definition.
+ * Objects imported using the IMPORT macros are added automatically.
+ *
+ * 		DEFINE_FSTR_ARRAY(calibration, uint16_t, ...);
+ * 		FSTR_CATALOGUE_ADD(calibration)
+ */
+#define FSTR_CATALOGUE_ADD(name) FSTR_CATALOGUE_ENTRY(name, FSTR_DATA_NAME(name).object)
+
+namespace FSTR
+{
+class ObjectBase;
+
+/**
+ * @brief Register of all objects, so they can be checked at startup
+ *
+ * Build with `FSTR_CATALOGUE=1` and every object imported using the IMPORT macros places a pointer
+ * to itself in the `fstr_catalogue` linker section. Objects defined at file scope using the DEFINE
+ * macros can be added using `FSTR_CATALOGUE_ADD`. The entire set can then be validated with a
+ * single call to `validate()`, typically early in `init()`.
+ *
+ * This catches a corrupt or misaligned flash image before it causes a crash.
+ * With this check in place, release builds omit the `isFlashPtr()` check from `ObjectBase::data()`,
+ * see `FSTR_CHECK_FLASH_PTR`.
+ *
+ * Objects defined within functions cannot be added: those in inline functions are placed in
+ * separate section groups, which conflict with the catalogue section.
+ *
+ * Each entry is a pointer, so costs 4 bytes. The section isn't named in the linker script so
+ * is placed with other read-only data which, on the Esp8266, is in RAM.
+ * `count() * sizeof(ObjectBase*)` gives the total.
+ *
+ * @note Registering an object prevents the linker from discarding it if unused.
+ */
+namespace Catalogue
+{
+/**
+ * @brief Reason an object failed validation
+ */
+enum class Error {
+	none,
+	alignment, ///< Object is not word-aligned
+	address,   ///< Object is not in flash memory
+	header,	///< Length field is invalid, or element size doesn't match length
+	bounds,	///< Object data extends beyond mapped flash memory
+	digest,	///< Stored digest doesn't match content
+};
+
+/**
+ * @brief Called for each object which fails validation
+ */
+using FailureCallback = void (*)(const ObjectBase& object, Error error);
+
+/**
+ * @brief Summary of a validation pass
+ */
+struct Report {
+	unsigned objects;  ///< Number of objects checked
+	unsigned failures; ///< Number of objects which failed
+	size_t bytes;	  ///< Total length of objects which passed
+	uint32_t cycles;   ///< CPU cycles taken by the validation pass
+	const ObjectBase* firstFailure;
+	Error firstError;
+
+	explicit operator bool() const
+	{
+		return failures == 0;
+	}
+
+	size_t printTo(Print& p) const;
+};
+
+/**
+ * @brief Get a description of an error
+ */
+const char* toString(Error error);
+
+/**
+ * @brief Check a single object
+ * @param object Must be an actual object, not a copy
+ * @param verifyDigest If the object has a stored digest, read the content and compare
+ * @retval Error
+ */
+Error check(const ObjectBase& object, bool verifyDigest = false);
+
+#if FSTR_CATALOGUE
+
+/**
+ * @brief Get the number of catalogue entries
+ */
+unsigned count();
+
+/**
+ * @brief Get a catalogue entry
+ * @param index
+ * @retval const ObjectBase* nullptr if index is out of range
+ * @note Entries are in link order
+ */
+const ObjectBase* entryAt(unsigned index);
+
+/**
+ * @brief Check every object in the catalogue
+ * @param verifyDigests Set to read and verify content of objects with a stored digest.
+ * This reads the whole object so takes considerably longer.
+ * @param callback Optional function to call for each failure
+ * @retval Report
+ */
+Report validate(bool verifyDigests = false, FailureCallback callback = nullptr);
+
+#else
+
+inline unsigned count()
+{
+	return 0;
+}
+
+inline const ObjectBase* entryAt(unsigned)
+{
+	return nullptr;
+}
+
+inline Report validate(bool = false, FailureCallback = nullptr)
+{
+	return Report{};
+}
+
+#endif
+
+} // namespace Catalogue
+
+} // namespace FSTR
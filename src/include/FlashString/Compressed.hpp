@@ -0,0 +1,128 @@
+/****
+ * Compressed.hpp - Defines the Compressed class and associated macros
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#pragma once
+
+#include "Object.hpp"
+#include "Print.hpp"
+
+/**
+ * @defgroup fstr_compressed Compressed objects
+ * @ingroup FlashString
+ * @{
+ */
+
+/**
+ * @brief Declare a global Compressed& reference
+ * @param name
+ * @note Use IMPORT_FSTR_COMPRESSED to instantiate the global object
+ */
+#define DECLARE_FSTR_COMPRESSED(name) DECLARE_FSTR_OBJECT(name, FSTR::Compressed)
+
+/**
+ * @brief Import a compressed file with reference
+ * @param name Name for the object
+ * @param file Absolute path to the file, as generated by `tools/fstr-compress.py`
+ * @note Can only be used at file scope
+ */
+#define IMPORT_FSTR_COMPRESSED(name, file) IMPORT_FSTR_OBJECT(name, FSTR::Compressed, file)
+
+/**
+ * @brief Like IMPORT_FSTR_COMPRESSED except reference is declared static constexpr
+ */
+#define IMPORT_FSTR_COMPRESSED_LOCAL(name, file) IMPORT_FSTR_OBJECT_LOCAL(name, FSTR::Compressed, file)
+
+namespace FSTR
+{
+/**
+ * @brief Compression method used for content
+ */
+enum class Compression : uint8_t {
+	none,
+	lzss, ///< Decompressed on reading
+	gzip, ///< Content is served as-is, client must decompress
+};
+
+/**
+ * @brief Header at start of Compressed object data
+ */
+struct CompressionHeader {
+	uint32_t length;	 ///< Uncompressed length of content
+	Compression method;  ///< How content is compressed
+	uint8_t windowBits;  ///< Size of LZSS window, as a power of 2
+	uint16_t reserved;   ///< Set to 0
+	// uint8_t content[]
+};
+
+static_assert(sizeof(CompressionHeader) == 8, "CompressionHeader size incorrect");
+
+/**
+ * @brief Describes compressed content stored in flash
+ *
+ * Object data consists of a `CompressionHeader` followed by the compressed content.
+ * Files are prepared using `tools/fstr-compress.py`. Use a `CompressedStream` to read the content.
+ */
+class Compressed : public Object<Compressed, uint8_t>
+{
+public:
+	/**
+	 * @brief Get the header information
+	 * @retval CompressionHeader Method will be `none` if object is invalid
+	 */
+	CompressionHeader header() const
+	{
+		CompressionHeader hdr{};
+		if(read(0, reinterpret_cast<uint8_t*>(&hdr), sizeof(hdr)) != sizeof(hdr)) {
+			hdr = CompressionHeader{};
+		}
+		return hdr;
+	}
+
+	Compression method() const
+	{
+		return header().method;
+	}
+
+	/**
+	 * @brief Get the length of the uncompressed content
+	 */
+	size_t uncompressedLength() const
+	{
+		return header().length;
+	}
+
+	/**
+	 * @brief Get the length of the stored content, excluding header
+	 */
+	size_t contentLength() const
+	{
+		auto len = length();
+		return (len > sizeof(CompressionHeader)) ? len - sizeof(CompressionHeader) : 0;
+	}
+
+	/**
+	 * @brief Print the uncompressed content
+	 * @note gzip content is output as-is
+	 */
+	size_t printTo(Print& p) const;
+};
+
+} // namespace FSTR
+
+/** @} */
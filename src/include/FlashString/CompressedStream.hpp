@@ -0,0 +1,111 @@
+/****
+ * CompressedStream.hpp - Stream for reading Compressed objects
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#pragma once
+
+#include "Compressed.hpp"
+#include <Data/Stream/DataSourceStream.h>
+
+namespace FSTR
+{
+/**
+ * @brief Stream which decompresses content from flash incrementally
+ * @ingroup fstr_stream
+ *
+ * LZSS content is decoded into a RAM window whose size is given in the object header,
+ * typically 1K. Compressed data is read from flash using `flashmem_read()` in small blocks.
+ *
+ * gzip content is not decompressed, but output as-is. Use `getContentEncoding()`
+ * to obtain the value to use for the HTTP `Content-Encoding` header.
+ *
+ * Seeking forward decompresses and discards data. Seeking back is only possible
+ * within the window, otherwise decompression must restart from the beginning.
+ */
+class CompressedStream : public IDataSourceStream
+{
+public:
+	CompressedStream(const Compressed& object);
+
+	~CompressedStream()
+	{
+		delete[] window;
+	}
+
+	// Owns the window buffer
+	CompressedStream(const CompressedStream&) = delete;
+	CompressedStream& operator=(const CompressedStream&) = delete;
+
+	StreamType getStreamType() const override
+	{
+		return (header.method == Compression::none) ? eSST_Invalid : eSST_Memory;
+	}
+
+	/**
+	 * @brief Return the number of uncompressed bytes remaining
+	 */
+	int available() override
+	{
+		return outputLength() - readPos;
+	}
+
+	uint16_t readMemoryBlock(char* data, int bufSize) override;
+
+	int seekFrom(int offset, SeekOrigin origin) override;
+
+	bool isFinished() override
+	{
+		return readPos >= outputLength();
+	}
+
+	/**
+	 * @brief Get the content encoding for the stream output
+	 * @retval const char* "gzip" for passthrough content, otherwise nullptr
+	 */
+	const char* getContentEncoding() const
+	{
+		return (header.method == Compression::gzip) ? "gzip" : nullptr;
+	}
+
+private:
+	size_t outputLength() const
+	{
+		return (header.method == Compression::gzip) ? object.contentLength() : header.length;
+	}
+
+	void reset();
+	int getByte();
+	void decode(size_t limit);
+
+	const Compressed& object;
+	CompressionHeader header;
+	uint8_t* window = nullptr; ///< Ring buffer containing most recently decoded data
+	size_t windowMask = 0;
+	size_t readPos = 0;		   ///< Position of next byte to be returned
+	size_t decodePos = 0;	  ///< Number of bytes decoded
+	size_t inputPos = 0;	   ///< Offset of next block to read from compressed content
+	uint8_t input[32];		   ///< Compressed data buffer
+	uint8_t inputLength = 0;
+	uint8_t inputIndex = 0;
+	uint8_t flags = 0;		   ///< Flag bits for current group of tokens
+	uint8_t flagCount = 0;	 ///< Number of bits remaining in flags
+	uint16_t matchOffset = 0;
+	uint16_t matchLength = 0; ///< Bytes remaining to be copied for current match
+};
+
+} // namespace FSTR
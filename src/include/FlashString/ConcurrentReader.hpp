@@ -0,0 +1,218 @@
+/****
+ * ConcurrentReader.hpp - Cached access to objects shared between tasks
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#pragma once
+
+#include "Object.hpp"
+#include <atomic>
+
+namespace FSTR
+{
+/**
+ * @brief Provides cached access to a large object from several tasks or cores at once
+ * @ingroup fstr_object
+ * @tparam ObjectType Type of object to read, such as `Array<uint16_t>`
+ * @tparam BlockSize Size of each cache slot in bytes
+ * @tparam Slots Number of cache slots
+ *
+ * Like `CachedReader`, except a single instance may be shared without locking.
+ * All read methods are positional and there is no read cursor.
+ *
+ * Each block of the object maps to one slot. A slot is protected by a sequence counter,
+ * which is odd while the slot is being filled:
+ *
+ * - A reader copies data from the slot and then checks the counter is unchanged.
+ * - On a miss, the reader claims the slot with compare-and-swap, reads the block using
+ *   `Object::readFlash()` then releases the slot.
+ * - If the slot is already being filled, the reader goes directly to flash instead of waiting.
+ *
+ * No task ever waits for another, and cached blocks are shared by all readers.
+ * Slot data is stored as atomic words, so a reader copying a slot which is being filled
+ * gets stale words rather than causing a data race. The sequence check then discards them.
+ *
+ * @note On single-core targets without pre-emption, such as the Esp8266, `CachedReader` is more efficient.
+ */
+template <class ObjectType, size_t BlockSize = 64, size_t Slots = 4> class ConcurrentReader
+{
+public:
+	using ElementType = typename ObjectType::Iterator::value_type;
+	using Iterator = ObjectIterator<ConcurrentReader, ElementType>;
+
+	static constexpr size_t blockElements = BlockSize / sizeof(ElementType);
+	static_assert(blockElements != 0, "ConcurrentReader BlockSize too small for element");
+	static_assert(Slots != 0, "ConcurrentReader requires at least one slot");
+
+	ConcurrentReader(const ObjectType& object) : object(object)
+	{
+	}
+
+	Iterator begin() const
+	{
+		return Iterator(*this, 0);
+	}
+
+	Iterator end() const
+	{
+		return Iterator(*this, length());
+	}
+
+	/**
+	 * @brief Get the object length in elements
+	 */
+	size_t length() const
+	{
+		return object.length();
+	}
+
+	/**
+	 * @brief Read an element, via the cache
+	 * @param index
+	 * @retval ElementType Default-constructed value if index is out of range
+	 */
+	ElementType valueAt(unsigned index) const
+	{
+		ElementType value{};
+		readBlock(index, &value, 1);
+		return value;
+	}
+
+	ElementType operator[](unsigned index) const
+	{
+		return valueAt(index);
+	}
+
+	/**
+	 * @brief Read elements into RAM, via the cache
+	 * @param index First element to read
+	 * @param buffer Where to store data
+	 * @param count How many elements to read
+	 * @retval size_t Number of elements actually read
+	 * @note Requests for a block or more are read directly from flash
+	 */
+	size_t read(size_t index, ElementType* buffer, size_t count) const
+	{
+		if(count >= blockElements) {
+			return object.readFlash(index, buffer, count);
+		}
+
+		size_t total = 0;
+		size_t n;
+		while(count != 0 && (n = readBlock(index, buffer, count)) != 0) {
+			buffer += n;
+			index += n;
+			count -= n;
+			total += n;
+		}
+
+		return total;
+	}
+
+	/**
+	 * @brief Get the underlying object
+	 */
+	const ObjectType& getObject() const
+	{
+		return object;
+	}
+
+private:
+	static constexpr size_t blockBytes = blockElements * sizeof(ElementType);
+	static constexpr size_t slotWords = ALIGNUP4(blockBytes) / sizeof(uint32_t);
+
+	struct Slot {
+		std::atomic<uint32_t> sequence{0};
+		std::atomic<size_t> blockIndex{0};
+		std::atomic<size_t> count{0};
+		std::atomic<uint32_t> data[slotWords];
+	};
+
+	/*
+	 * Copy elements from a slot using word-sized relaxed loads
+	 */
+	static void loadSlot(const Slot& slot, size_t offset, ElementType* buffer, size_t count)
+	{
+		uint32_t words[slotWords];
+		auto start = offset * sizeof(ElementType);
+		auto end = start + count * sizeof(ElementType);
+		for(auto i = start / sizeof(uint32_t); i < ALIGNUP4(end) / sizeof(uint32_t); ++i) {
+			words[i] = slot.data[i].load(std::memory_order_relaxed);
+		}
+		memcpy(buffer, reinterpret_cast<const uint8_t*>(words) + start, end - start);
+	}
+
+	/*
+	 * Fill a slot using word-sized relaxed stores
+	 */
+	static void storeSlot(Slot& slot, const ElementType* block)
+	{
+		uint32_t words[slotWords]{};
+		memcpy(words, block, blockBytes);
+		for(unsigned i = 0; i < slotWords; ++i) {
+			slot.data[i].store(words[i], std::memory_order_relaxed);
+		}
+	}
+
+	/*
+	 * Read elements from a single block
+	 * Returns number of elements read, 0 if index is out of range
+	 */
+	size_t readBlock(size_t index, ElementType* buffer, size_t count) const
+	{
+		auto len = object.length();
+		if(index >= len) {
+			return 0;
+		}
+
+		auto blockIndex = index - (index % blockElements);
+		auto offset = index - blockIndex;
+		count = std::min(count, std::min(blockElements - offset, len - index));
+		auto& slot = slots[(blockIndex / blockElements) % Slots];
+
+		auto seq = slot.sequence.load(std::memory_order_acquire);
+		if((seq & 1) == 0) {
+			if(slot.blockIndex.load(std::memory_order_relaxed) == blockIndex &&
+			   offset + count <= slot.count.load(std::memory_order_relaxed)) {
+				loadSlot(slot, offset, buffer, count);
+				std::atomic_thread_fence(std::memory_order_acquire);
+				if(slot.sequence.load(std::memory_order_relaxed) == seq) {
+					return count;
+				}
+			} else if(slot.sequence.compare_exchange_strong(seq, seq + 1, std::memory_order_acquire)) {
+				// Readers must not see new data with the old sequence value
+				std::atomic_thread_fence(std::memory_order_release);
+				ElementType block[blockElements]{};
+				auto n = object.readFlash(blockIndex, block, blockElements);
+				storeSlot(slot, block);
+				slot.blockIndex.store(blockIndex, std::memory_order_relaxed);
+				slot.count.store(n, std::memory_order_relaxed);
+				memcpy(buffer, &block[offset], count * sizeof(ElementType));
+				slot.sequence.store(seq + 2, std::memory_order_release);
+				return count;
+			}
+		}
+
+		// Slot is busy or changed while reading
+		return object.readFlash(index, buffer, count);
+	}
+
+	const ObjectType& object;
+	mutable Slot slots[Slots];
+};
+
+} // namespace FSTR
@@ -0,0 +1,258 @@
+/****
+ * FileMap.hpp - Hashed directory of imported files
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#pragma once
+
+#include "HashedMap.hpp"
+#include "Compressed.hpp"
+#include <Data/Stream/DataSourceStream.h>
+
+/**
+ * @defgroup fstr_filemap FileMap
+ * @ingroup FlashString
+ * @{
+ */
+
+/**
+ * @brief Declare a global FileMap& reference
+ * @param name Name of the FileMap& reference to define
+ * @note Use DEFINE_FSTR_FILEMAP to instantiate the global object
+ */
+#define DECLARE_FSTR_FILEMAP(name) DECLARE_FSTR_OBJECT(name, FSTR::FileMap)
+
+/**
+ * @brief Define a FileMap Object with global reference
+ * @param name Name of the FileMap& reference to define
+ * @param seed Hash seed value
+ * @param index Pointer to displacement table, an `Array<int16_t>`
+ * @param ... List of FileEntry definitions { &path, &content, &mimeType, size, etag, compression },
+ * in hash slot order
+ * @note Use `tools/filemap.py` to generate the definition from a directory
+ */
+#define DEFINE_FSTR_FILEMAP(name, seed, index, ...)                                                                    \
+	static DEFINE_FSTR_FILEMAP_DATA(FSTR_DATA_NAME(name), seed, index, __VA_ARGS__);                                   \
+	DEFINE_FSTR_REF_NAMED(name, FSTR::FileMap);
+
+/**
+ * @brief Like DEFINE_FSTR_FILEMAP except reference is declared static constexpr
+ */
+#define DEFINE_FSTR_FILEMAP_LOCAL(name, seed, index, ...)                                                              \
+	static DEFINE_FSTR_FILEMAP_DATA(FSTR_DATA_NAME(name), seed, index, __VA_ARGS__);                                   \
+	static constexpr DEFINE_FSTR_REF_NAMED(name, FSTR::FileMap);
+
+/**
+ * @brief Define a FileMap data structure
+ * @param name Name of data structure
+ * @param seed Hash seed value
+ * @param index Pointer to displacement table
+ * @param ... List of FileEntry definitions, in hash slot order
+ * @note Hash information follows the entries, but is not included in the object length
+ */
+#define DEFINE_FSTR_FILEMAP_DATA(name, seed, index, ...)                                                               \
+	constexpr const struct {                                                                                           \
+		FSTR::ObjectBase object;                                                                                       \
+		FSTR::FileEntry data[sizeof((const FSTR::FileEntry[]){__VA_ARGS__}) / sizeof(FSTR::FileEntry)];                \
+		FSTR::MapHashInfo hash;                                                                                        \
+	} FSTR_PACKED FSTR_ALIGNED name PROGMEM = {{sizeof(name.data)}, {__VA_ARGS__}, {seed, index}};                     \
+	FSTR_CHECK_STRUCT(name);
+
+namespace FSTR
+{
+/**
+ * @brief Describes one file in a FileMap
+ *
+ * All information required to serve a file is held in the index,
+ * so headers can be sent without reading the content.
+ */
+struct FileEntry {
+	typedef void (FileEntry::*IfHelperType)() const;
+	void IfHelper() const
+	{
+	}
+
+	/**
+	 * @brief Provides bool() operator to determine if entry is valid
+	 */
+	operator IfHelperType() const
+	{
+		return content_ ? &FileEntry::IfHelper : 0;
+	}
+
+	/**
+	 * @brief Get the file path, relative to the imported directory
+	 */
+	const String& path() const
+	{
+		return (path_ == nullptr) ? String::empty() : *path_;
+	}
+
+	/**
+	 * @brief Get the stored content, which is a `Compressed` object unless compression is `none`
+	 */
+	const ObjectBase& content() const
+	{
+		return (content_ == nullptr) ? String::empty() : *content_;
+	}
+
+	/**
+	 * @brief Get the MIME type, e.g. "text/html"
+	 */
+	const String& mimeType() const
+	{
+		return (mimeType_ == nullptr) ? String::empty() : *mimeType_;
+	}
+
+	/**
+	 * @brief Get the number of bytes produced by `createStream()`
+	 */
+	size_t size() const
+	{
+		return size_;
+	}
+
+	/**
+	 * @brief Get a hash of the content, suitable for use as an HTTP ETag
+	 */
+	uint32_t etag() const
+	{
+		return etag_;
+	}
+
+	Compression compression() const
+	{
+		return compression_;
+	}
+
+	/**
+	 * @brief Get the content encoding for the stream output
+	 * @retval const char* "gzip" for passthrough content, otherwise nullptr
+	 */
+	const char* contentEncoding() const
+	{
+		return (compression_ == Compression::gzip) ? "gzip" : nullptr;
+	}
+
+	/**
+	 * @brief Create a stream to read the content
+	 * @retval IDataSourceStream* A `Stream` for uncompressed content, otherwise a `CompressedStream`.
+	 * nullptr if the entry is invalid.
+	 * @note Caller is responsible for destroying the stream
+	 */
+	IDataSourceStream* createStream() const;
+
+	size_t printTo(Print& p) const;
+
+	/* Private member data */
+
+	const String* path_;
+	const ObjectBase* content_;
+	const String* mimeType_;
+	uint32_t size_;
+	uint32_t etag_;
+	Compression compression_;
+};
+
+/**
+ * @brief A directory of files, generated at build time, with single-probe path lookup
+ *
+ * Paths are located using a perfect hash, as for `HashedMap`. A lookup hashes the path once
+ * then makes a single String comparison.
+ *
+ * Example:
+ *
+ * 		DECLARE_FSTR_FILEMAP(webFiles); // Generated by tools/filemap.py
+ * 		...
+ * 		auto stream = webFiles.open(request.uri.getRelativePath());
+ * 		if(stream != nullptr) {
+ * 			response.sendDataStream(stream);
+ * 		}
+ */
+class FileMap : public Object<FileMap, FileEntry>
+{
+public:
+	/**
+	 * @brief Lookup a path and return the index
+	 * @param path
+	 * @param ignoreCase Whether search is case-sensitive (default: false)
+	 * @retval int If path isn't found, return -1
+	 */
+	template <typename TRefKey> int indexOf(const TRefKey& path, bool ignoreCase = false) const
+	{
+		Stats::Measure measure(*this, Stats::Event::lookup);
+		auto pathHash = Hash::calculate(path);
+		int slot = hashInfo().findSlot(pathHash, length());
+		if(slot < 0) {
+			return -1;
+		}
+		measure.probe();
+
+		auto& entryPath = data()[slot].path();
+		if(!entryPath.matchesHash(pathHash)) {
+			return -1;
+		}
+		if(ignoreCase ? entryPath.equalsIgnoreCase(path) : (entryPath == path)) {
+			return slot;
+		}
+
+		return -1;
+	}
+
+	/**
+	 * @brief Lookup a path and return the entry
+	 * @param path
+	 * @param ignoreCase
+	 * @note Result validity can be checked using if()
+	 */
+	template <typename TRefKey> FileEntry find(const TRefKey& path, bool ignoreCase = false) const
+	{
+		return valueAt(indexOf(path, ignoreCase));
+	}
+
+	template <typename TRefKey> FileEntry operator[](const TRefKey& path) const
+	{
+		return find(path);
+	}
+
+	/**
+	 * @brief Open a file for reading
+	 * @param path
+	 * @param ignoreCase
+	 * @retval IDataSourceStream* nullptr if file not found
+	 * @see See `FileEntry::createStream()`
+	 */
+	template <typename TRefKey> IDataSourceStream* open(const TRefKey& path, bool ignoreCase = false) const
+	{
+		return find(path, ignoreCase).createStream();
+	}
+
+	/**
+	 * @brief Print a listing of all files, one per line
+	 */
+	size_t printTo(Print& p) const;
+
+private:
+	const MapHashInfo& hashInfo() const
+	{
+		return *reinterpret_cast<const MapHashInfo*>(data() + length());
+	}
+};
+
+} // namespace FSTR
+
+/** @} */
@@ -0,0 +1,175 @@
+/****
+ * HashedMap.hpp - Defines the HashedMap class template and associated macros
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#pragma once
+
+#include "Map.hpp"
+#include "Array.hpp"
+
+/**
+ * @addtogroup fstr_map
+ * @{
+ */
+
+/**
+ * @brief Declare a global HashedMap& reference
+ * @param name Name of the HashedMap& reference to define
+ * @param ContentType Object type to declare for content
+ * @note Use DEFINE_FSTR_MAP_HASHED to instantiate the global object
+ */
+#define DECLARE_FSTR_MAP_HASHED(name, ContentType) DECLARE_FSTR_OBJECT(name, FSTR::HashedMap<ContentType>)
+
+/**
+ * @brief Define a HashedMap Object with global reference
+ * @param name Name of the HashedMap& reference to define
+ * @param ContentType Object type to declare for content
+ * @param seed Hash seed value
+ * @param index Pointer to displacement table, an `Array<int16_t>`
+ * @param ... List of MapPair definitions { &key, &content }, in hash slot order
+ * @note Use `tools/maphash.py` to generate the seed, index and pair ordering
+ */
+#define DEFINE_FSTR_MAP_HASHED(name, ContentType, seed, index, ...)                                                    \
+	static DEFINE_FSTR_MAP_DATA_HASHED(FSTR_DATA_NAME(name), ContentType, seed, index, __VA_ARGS__);                   \
+	DEFINE_FSTR_REF_NAMED(name, FSTR::HashedMap<ContentType>);
+
+/**
+ * @brief Like DEFINE_FSTR_MAP_HASHED except reference is declared static constexpr
+ */
+#define DEFINE_FSTR_MAP_HASHED_LOCAL(name, ContentType, seed, index, ...)                                              \
+	static DEFINE_FSTR_MAP_DATA_HASHED(FSTR_DATA_NAME(name), ContentType, seed, index, __VA_ARGS__);                   \
+	static constexpr DEFINE_FSTR_REF_NAMED(name, FSTR::HashedMap<ContentType>);
+
+/**
+ * @brief Define a HashedMap data structure
+ * @param name Name of data structure
+ * @param ContentType Object type to declare for content
+ * @param seed Hash seed value
+ * @param index Pointer to displacement table
+ * @param ... List of MapPair definitions { &key, &content }, in hash slot order
+ * @note Hash information follows the map entries, but is not included in the object length
+ */
+#define DEFINE_FSTR_MAP_DATA_HASHED(name, ContentType, seed, index, ...)                                               \
+	constexpr const struct {                                                                                           \
+		FSTR::ObjectBase object;                                                                                       \
+		FSTR::MapPair<FSTR::String, ContentType>                                                                       \
+			data[sizeof((const FSTR::MapPair<FSTR::String, ContentType>[]){__VA_ARGS__}) /                             \
+				 sizeof(FSTR::MapPair<FSTR::String, ContentType>)];                                                    \
+		FSTR::MapHashInfo hash;                                                                                        \
+	} FSTR_PACKED FSTR_ALIGNED name PROGMEM = {                                                                        \
+		{FSTR::ObjectBase::typedLength(sizeof(name.data), FSTR::Type::stringMap, sizeof(void*))},                      \
+		{__VA_ARGS__},                                                                                                 \
+		{seed, index}};                                                                                                \
+	FSTR_CHECK_STRUCT(name);
+
+namespace FSTR
+{
+/**
+ * @brief Perfect hash information stored following HashedMap entries
+ * @ingroup fstr_map
+ */
+struct MapHashInfo {
+	uint32_t seed;
+	const Array<int16_t>* index;
+
+	/**
+	 * @brief Obtain candidate slot for a given key hash
+	 * @param hash Hash of key, from `Hash::calculate()`
+	 * @param count Number of slots
+	 * @retval int -1 if there are no slots
+	 *
+	 * The key hash is mixed with the seed, and the result selects an entry from the displacement table.
+	 * A negative entry `d` gives the slot directly as `-d-1`. Otherwise the slot is found by mixing
+	 * the hash again with `d`.
+	 */
+	int findSlot(uint32_t hash, size_t count) const
+	{
+		auto indexLength = index->length();
+		if(count == 0 || indexLength == 0) {
+			return -1;
+		}
+
+		hash = Hash::mix(hash ^ seed);
+		int16_t d = (*index)[hash % indexLength];
+		if(d < 0) {
+			return -d - 1;
+		}
+
+		return Hash::mix(hash ^ d) % count;
+	}
+};
+
+/**
+ * @brief Class template to access an associative map using a perfect hash
+ * @tparam ContentType
+ *
+ * Keys are always Strings. A lookup hashes the key once then makes a single key comparison.
+ * See `MapHashInfo::findSlot()` for details.
+ */
+template <class ContentType> class HashedMap : public Map<String, ContentType>
+{
+public:
+	using Pair = MapPair<String, ContentType>;
+
+	/**
+	 * @brief Lookup a String key and return the index
+	 * @param key
+	 * @param ignoreCase Whether search is case-sensitive (default: true)
+	 * @retval int If key isn't found, return -1
+	 */
+	template <typename TRefKey> int indexOf(const TRefKey& key, bool ignoreCase = true) const
+	{
+		Stats::Measure measure(*this, Stats::Event::lookup);
+		auto keyHash = Hash::calculate(key);
+		int slot = hashInfo().findSlot(keyHash, this->length());
+		if(slot < 0) {
+			return -1;
+		}
+		measure.probe();
+
+		auto& slotKey = this->data()[slot].key();
+		if(!slotKey.matchesHash(keyHash)) {
+			return -1;
+		}
+		if(ignoreCase ? slotKey.equalsIgnoreCase(key) : (slotKey == key)) {
+			return slot;
+		}
+
+		return -1;
+	}
+
+	/**
+	 * @brief Lookup a key and return the entry, if found
+	 * @param key
+	 * @note Result validity can be checked using if()
+	 */
+	template <typename TRefKey> const Pair operator[](const TRefKey& key) const
+	{
+		return this->valueAt(indexOf(key));
+	}
+
+private:
+	const MapHashInfo& hashInfo() const
+	{
+		return *reinterpret_cast<const MapHashInfo*>(this->data() + this->length());
+	}
+};
+
+} // namespace FSTR
+
+/** @} */
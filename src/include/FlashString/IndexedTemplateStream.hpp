@@ -0,0 +1,173 @@
+/****
+ * IndexedTemplateStream.hpp - Template stream using a pre-built segment index
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#pragma once
+
+#include "String.hpp"
+#include "Array.hpp"
+#include "Vector.hpp"
+#include <Data/Stream/DataSourceStream.h>
+
+namespace FSTR
+{
+/**
+ * @brief Describes a run of literal template text followed by an optional variable
+ * @ingroup fstr_stream
+ * @note Generated using `tools/fstr-template.py`
+ */
+struct TemplateSegment {
+	static constexpr uint16_t noVariable = 0xFFFF;
+
+	uint32_t offset;   ///< Start of literal text in template content
+	uint16_t length;   ///< Length of literal text
+	uint16_t variable; ///< Index of variable following the text, or `noVariable`
+};
+
+static_assert(sizeof(TemplateSegment) == 8, "TemplateSegment size incorrect");
+
+/**
+ * @brief Template stream which uses a segment index generated at build time
+ * @ingroup fstr_stream
+ *
+ * `FSTR::TemplateStream` scans the whole template for `{var}` markers every time it is rendered.
+ * Here, the template is parsed on the host by `tools/fstr-template.py`, which generates an
+ * `Array<TemplateSegment>` and a `Vector<String>` of variable names in addition to the content.
+ *
+ * The stream moves directly from one segment to the next. Literal text is read from flash
+ * without being examined, and may be accessed without copying via `getStreamPointer()`.
+ *
+ * Variables which have not been set produce no output.
+ */
+class IndexedTemplateStream : public IDataSourceStream
+{
+public:
+	/**
+	 * @brief Constructor
+	 * @param content The template
+	 * @param segments Segment index for the template
+	 * @param variables Names of variables, referred to by index from segments
+	 */
+	IndexedTemplateStream(const String& content, const Array<TemplateSegment>& segments,
+						  const Vector<String>& variables);
+
+	~IndexedTemplateStream()
+	{
+		delete[] values;
+	}
+
+	IndexedTemplateStream(const IndexedTemplateStream&) = delete;
+	IndexedTemplateStream& operator=(const IndexedTemplateStream&) = delete;
+
+	/**
+	 * @brief Set value of a variable by index
+	 * @param index Index of variable in names Vector
+	 * @param value
+	 */
+	void setVar(unsigned index, const ::String& value);
+
+	/**
+	 * @brief Set value of a variable by name
+	 * @param name
+	 * @param value
+	 * @retval bool false if the template doesn't use the variable
+	 */
+	bool setVar(const char* name, const ::String& value);
+
+	/**
+	 * @brief Get the number of variables used by the template
+	 */
+	unsigned variableCount() const
+	{
+		return variables.length();
+	}
+
+	StreamType getStreamType() const override
+	{
+		return eSST_Memory;
+	}
+
+	uint16_t readMemoryBlock(char* data, int bufSize) override;
+
+	/**
+	 * @brief Seek forward from the current position, or back to the start
+	 */
+	int seekFrom(int offset, SeekOrigin origin) override;
+
+	bool isFinished() override
+	{
+		start();
+		return segmentIndex >= segments.length();
+	}
+
+	/**
+	 * @brief Get a pointer to literal text at the current read position, without copying
+	 * @param length On return, number of bytes which may be accessed
+	 * @retval const char* nullptr if the current position is within a variable value
+	 * @note The data is in memory-mapped flash, so on the ESP8266 it must be accessed
+	 * using aligned 32-bit reads, for example via `memcpy_P()`.
+	 * Call `seek()` to advance the read position once the data has been consumed.
+	 */
+	const char* getStreamPointer(size_t& length);
+
+protected:
+	/**
+	 * @brief Get the value for a variable
+	 * @param index
+	 * @note Override to provide values dynamically
+	 */
+	virtual ::String getValue(unsigned index)
+	{
+		return (index < variables.length()) ? values[index] : ::String();
+	}
+
+private:
+	/*
+	 * First segment is loaded on first use, so getValue() overrides are called
+	 */
+	void start()
+	{
+		if(!started) {
+			started = true;
+			loadSegment();
+		}
+	}
+
+	/*
+	 * Load current segment and skip any which produce no output
+	 */
+	void loadSegment();
+
+	size_t segmentLength() const
+	{
+		return segment.length + value.length();
+	}
+
+	const String& content;
+	const Array<TemplateSegment>& segments;
+	const Vector<String>& variables;
+	::String* values;
+	TemplateSegment segment{};
+	::String value; ///< Value of variable for current segment
+	unsigned segmentIndex = 0;
+	size_t segmentPos = 0; ///< Read position within current segment
+	size_t readPos = 0;
+	bool started = false;
+};
+
+} // namespace FSTR
@@ -105,11 +105,82 @@
 	constexpr const struct {                                                                                           \
 		FSTR::ObjectBase object;                                                                                       \
 		FSTR::MapPair<KeyType, ContentType> data[size];                                                                \
-	} FSTR_PACKED FSTR_ALIGNED name PROGMEM = {{sizeof(name.data)}, {__VA_ARGS__}};                                    \
+	} FSTR_PACKED FSTR_ALIGNED name PROGMEM = {                                                                        \
+		{FSTR::ObjectBase::typedLength(sizeof(name.data), FSTR::mapType<KeyType>(), FSTR::mapKeySize<KeyType>())},     \
+		{__VA_ARGS__}};                                                                                                \
 	FSTR_CHECK_STRUCT(name);
 
+/**
+ * @brief Lookup a key in a Map at compile time
+ * @param objref Map defined in this translation unit using DEFINE_FSTR_MAP or similar
+ * @param key Integral or enum key
+ * @retval int Index of key, -1 if not found
+ * @note String keys cannot be inspected at compile time
+ */
+#define FSTR_INDEX_OF(objref, key) FSTR::constIndexOf(FSTR_DATA_NAME(objref), key)
+
+/**
+ * @brief Lookup a key in a Map at compile time and get a pointer to the content
+ * @param objref Map defined in this translation unit
+ * @param key Integral or enum key
+ * @retval const ContentType* nullptr if key not found
+ *
+ * With a constant key this compiles to a direct reference, with no code or flash reads:
+ *
+ * 		DEFINE_FSTR_MAP_LOCAL(errors, int, FSTR::String, {404, &notFound}, {500, &serverError});
+ * 		constexpr auto msg = FSTR_LOOKUP(errors, 404);
+ * 		Serial.println(*msg);
+ */
+#define FSTR_LOOKUP(objref, key) FSTR::constLookup(FSTR_DATA_NAME(objref), key)
+
 namespace FSTR
 {
+/**
+ * @brief Combine search results, used by `constIndexOf()`
+ */
+constexpr int firstMatch(int left, int right)
+{
+	return (left >= 0) ? left : right;
+}
+
+/**
+ * @brief Search part of a map data structure for a key at compile time
+ * @param map The map data structure
+ * @param key
+ * @param first Index of first pair to check
+ * @param last Index of last pair to check
+ * @retval int Index of first match, -1 if not found
+ * @note Range is split recursively to keep within the compiler's constexpr depth limit
+ */
+template <class MapData, typename TRefKey>
+constexpr int constIndexOf(const MapData& map, const TRefKey& key, size_t first, size_t last)
+{
+	return (first > last)	? -1
+		   : (first == last) ? ((map.data[first].key_ == key) ? int(first) : -1)
+							 : firstMatch(constIndexOf(map, key, first, (first + last) / 2),
+										  constIndexOf(map, key, (first + last) / 2 + 1, last));
+}
+
+/**
+ * @brief Search a map data structure for a key at compile time
+ * @see See `FSTR_INDEX_OF`
+ */
+template <class MapData, typename TRefKey> constexpr int constIndexOf(const MapData& map, const TRefKey& key)
+{
+	static_assert(!std::is_pointer<decltype(map.data[0].key_)>::value, "String keys cannot be compared at compile time");
+	return (constLength(map) == 0) ? -1 : constIndexOf(map, key, 0, constLength(map) - 1);
+}
+
+/**
+ * @brief Get content for a key at compile time
+ * @see See `FSTR_LOOKUP`
+ */
+template <class MapData, typename TRefKey>
+constexpr decltype(std::declval<MapData>().data[0].content_) constLookup(const MapData& map, const TRefKey& key)
+{
+	return (constIndexOf(map, key) < 0) ? nullptr : map.data[constIndexOf(map, key)].content_;
+}
+
 /**
  * @brief Class template to access an associative map
  * @tparam KeyType
@@ -143,9 +214,11 @@ public:
 	template <typename TRefKey, typename T = KeyType>
 	typename std::enable_if<!std::is_class<T>::value, int>::type indexOf(const TRefKey& key) const
 	{
-		auto p = this->data();
+		Stats::Measure measure(*this, Stats::Event::lookup);
+		auto p = pairs();
 		auto len = this->length();
 		for(unsigned i = 0; i < len; ++i, ++p) {
+			measure.probe();
 			if(p->key() == key) {
 				return i;
 			}
@@ -164,14 +237,21 @@ public:
 	typename std::enable_if<std::is_same<T, String>::value, int>::type indexOf(const TRefKey& key,
 																			   bool ignoreCase = true) const
 	{
-		auto p = this->data();
+		Stats::Measure measure(*this, Stats::Event::lookup);
+		Hash::LazyKey<TRefKey> keyHash(key);
+		auto p = pairs();
 		auto len = this->length();
 		for(unsigned i = 0; i < len; ++i, ++p) {
+			measure.probe();
+			auto& k = p->key();
+			if(!keyHash.mayMatch(k)) {
+				continue;
+			}
 			if(ignoreCase) {
-				if(p->key().equalsIgnoreCase(key)) {
+				if(k.equalsIgnoreCase(key)) {
 					return i;
 				}
-			} else if(p->key() == key) {
+			} else if(k == key) {
 				return i;
 			}
 		}
@@ -195,15 +275,35 @@ public:
 	 * @brief Returns a printer object for this array
 	 * @note ElementType must be supported by Print
 	 */
-	MapPrinter<Map> printer() const
+	MapPrinter<Map> printer(const PrintFormat& format = PrintFormat()) const
 	{
-		return MapPrinter<Map>(*this);
+		return MapPrinter<Map>(*this, format);
 	}
 
 	size_t printTo(Print& p) const
 	{
 		return printer().printTo(p);
 	}
+
+	size_t printTo(Print& p, const PrintFormat& format) const
+	{
+		return printer(format).printTo(p);
+	}
+
+private:
+	/*
+	 * Entries to search, using a copy held by the active RamCache if there is one
+	 */
+	const Pair* pairs() const
+	{
+#if FSTR_RAM_CACHE
+		auto cached = this->cachedData();
+		if(cached != nullptr) {
+			return reinterpret_cast<const Pair*>(cached);
+		}
+#endif
+		return this->data();
+	}
 };
 
 } // namespace FSTR
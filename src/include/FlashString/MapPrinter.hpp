@@ -26,31 +26,39 @@ namespace FSTR
 /**
  * @brief Class template to provide a simple way to print the contents of a Map
  * @note Used by Map::printTo() method
+ *
+ * Output is collected in a stack buffer of FSTR_PRINT_BUFFER_SIZE bytes and written in blocks.
+ * By default, each entry is printed on a separate line.
  */
 template <class MapType> class MapPrinter : public Printable
 {
 public:
-	MapPrinter(const MapType& map) : map(map)
+	MapPrinter(const MapType& map, const PrintFormat& format = PrintFormat()) : map(map), format(format)
 	{
 	}
 
 	size_t printTo(Print& p) const override
 	{
-		size_t count = 0;
+		BufferedPrint<FSTR_PRINT_BUFFER_SIZE> out(p);
 
-		count += p.println("{");
-		for(unsigned i = 0; i < map.length(); ++i) {
-			count += p.print("  ");
-			count += map.valueAt(i).printTo(p);
-			count += p.println();
+		auto len = map.length();
+		// Default output for an empty map is "{\r\n}"
+		out.print(format.prefix ? format.prefix : (len == 0) ? "{\r\n" : "{\r\n  ");
+		auto separator = format.separator ? format.separator : "\r\n  ";
+		for(unsigned i = 0; i < len; ++i) {
+			if(i > 0) {
+				out.print(separator);
+			}
+			map.valueAt(i).printTo(out);
 		}
-		count += p.print("}");
+		out.print(format.suffix ? format.suffix : (len == 0) ? "}" : "\r\n}");
 
-		return count;
+		return out.flush();
 	}
 
 private:
 	const MapType& map;
+	PrintFormat format;
 };
 
 } // namespace FSTR
@@ -0,0 +1,139 @@
+/****
+ * MultiStream.hpp - Stream a sequence of objects as one
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#pragma once
+
+#include "Slice.hpp"
+#include <Data/Stream/DataSourceStream.h>
+
+namespace FSTR
+{
+/**
+ * @brief Stream the content of several objects, or ranges within them, as a single stream
+ * @ingroup fstr_stream
+ *
+ * Parts are held in a fixed table within the stream, so no allocation is made for each part.
+ * A single `readMemoryBlock()` call fills the buffer across part boundaries.
+ *
+ * Example:
+ *
+ * 		auto stream = new FSTR::MultiStream;
+ * 		stream->add(pageHeader);
+ * 		stream->add(content.c_str(), content.length());
+ * 		stream->add(pageFooter);
+ * 		response.sendDataStream(stream, MIME_HTML);
+ *
+ * RAM data isn't copied, so it must remain valid for the life of the stream.
+ */
+class MultiStream : public IDataSourceStream
+{
+public:
+	/**
+	 * @brief Maximum number of parts
+	 */
+	static constexpr unsigned maxParts = FSTR_MULTISTREAM_MAX_PARTS;
+
+	/**
+	 * @brief Add an object, or part of one
+	 * @param object
+	 * @param offset Start position within object
+	 * @param length Number of bytes, truncated to the object length
+	 * @retval bool false if the stream is full
+	 */
+	bool add(const ObjectBase& object, size_t offset = 0, size_t length = SIZE_MAX);
+
+	/**
+	 * @brief Add a slice of an object
+	 * @param slice
+	 * @retval bool false if the stream is full
+	 */
+	bool add(const Slice& slice)
+	{
+		return add(slice.object(), slice.offset(), slice.length());
+	}
+
+	/**
+	 * @brief Add a block of data in RAM
+	 * @param data
+	 * @param length
+	 * @retval bool false if the stream is full
+	 * @note Data is not copied
+	 */
+	bool add(const char* data, size_t length);
+
+	/**
+	 * @brief Get the number of parts which have been added
+	 */
+	unsigned count() const
+	{
+		return partCount;
+	}
+
+	/**
+	 * @brief Get the total length of all parts
+	 */
+	size_t length() const
+	{
+		return totalLength;
+	}
+
+	/**
+	 * @brief Remove all parts and reset the read position
+	 */
+	void clear();
+
+	StreamType getStreamType() const override
+	{
+		return eSST_Memory;
+	}
+
+	int available() override
+	{
+		return totalLength - readPos;
+	}
+
+	uint16_t readMemoryBlock(char* data, int bufSize) override;
+
+	int seekFrom(int offset, SeekOrigin origin) override;
+
+	bool isFinished() override
+	{
+		return readPos >= totalLength;
+	}
+
+private:
+	struct Part {
+		const ObjectBase* object; ///< nullptr for RAM data
+		const char* ramData;
+		size_t offset; ///< Start position within object
+		size_t length;
+	};
+
+	size_t readPart(const Part& part, size_t offset, char* buffer, size_t count);
+	void locate(size_t pos);
+
+	Part parts[maxParts];
+	unsigned partCount = 0;
+	size_t totalLength = 0;
+	size_t readPos = 0;
+	unsigned partIndex = 0; ///< Part containing readPos
+	size_t partStart = 0;   ///< Stream position of current part
+};
+
+} // namespace FSTR
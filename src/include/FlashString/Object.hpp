@@ -23,6 +23,8 @@
 
 #include "Utility.hpp"
 #include "ObjectBase.hpp"
+#include "Slice.hpp"
+#include "Catalogue.hpp"
 #include "ObjectIterator.hpp"
 
 /**
@@ -81,6 +83,29 @@
  */
 #define FSTR_PTR(objref) static_cast<std::remove_reference<decltype(objref)>::type*>(&FSTR_DATA_NAME(objref).object)
 
+/**
+ * @brief Get the number of elements in an object at compile time
+ * @param objref Object defined in this translation unit using one of the DEFINE_FSTR macros
+ * @retval size_t Number of characters for a String, elements for an Array or Vector, or pairs for a Map
+ * @note Imported objects have no visible data structure and will fail to compile.
+ *
+ * Object methods such as `length()` read from flash at runtime as the object may be a copy.
+ * Where the data structure is in scope this can be evaluated by the compiler instead:
+ *
+ * 		DEFINE_FSTR_ARRAY_LOCAL(table, uint16_t, 1, 2, 3, 4);
+ * 		uint16_t buffer[FSTR_LENGTH(table)];
+ */
+#define FSTR_LENGTH(objref) FSTR::constLength(FSTR_DATA_NAME(objref))
+
+/**
+ * @brief Get an element from an object at compile time
+ * @param objref Object defined in this translation unit, as for `FSTR_LENGTH`
+ * @param index
+ * @retval Element value, or default value if index is out of range.
+ * Vector elements are object pointers, nullptr if out of range.
+ */
+#define FSTR_VALUE_AT(objref, index) FSTR::constValueAt(FSTR_DATA_NAME(objref), index)
+
 /**
  * @brief Check structure is POD-compliant and correctly aligned
  */
@@ -99,7 +124,8 @@
 #define IMPORT_FSTR_OBJECT(name, ObjectType, file)                                                                     \
 	IMPORT_FSTR_DATA(FSTR_DATA_NAME(name), file)                                                                       \
 	extern "C" __attribute__((visibility("hidden"))) const FSTR::ObjectBase FSTR_DATA_NAME(name);                      \
-	DEFINE_FSTR_REF(name, ObjectType, FSTR_DATA_NAME(name));
+	DEFINE_FSTR_REF(name, ObjectType, FSTR_DATA_NAME(name));                                                           \
+	FSTR_CATALOGUE_ENTRY(name, FSTR_DATA_NAME(name))
 
 /**
  * @brief Like IMPORT_FSTR_OBJECT except reference is declared static constexpr
@@ -107,10 +133,64 @@
 #define IMPORT_FSTR_OBJECT_LOCAL(name, ObjectType, file)                                                               \
 	IMPORT_FSTR_DATA(FSTR_DATA_NAME(name), file)                                                                       \
 	extern "C" __attribute__((visibility("hidden"))) const FSTR::ObjectBase FSTR_DATA_NAME(name);                      \
-	static constexpr DEFINE_FSTR_REF(name, ObjectType, FSTR_DATA_NAME(name));
+	static constexpr DEFINE_FSTR_REF(name, ObjectType, FSTR_DATA_NAME(name));                                          \
+	FSTR_CATALOGUE_ENTRY(name, FSTR_DATA_NAME(name))
+
+/**
+ * @brief Import an object from an external file with reference, storing a digest of the content
+ * @param name Name for the object
+ * @param ObjectType Object type for reference
+ * @param file Absolute path to the file containing the content
+ * @param digest Digest value, generated using `tools/fstr-digest.py`
+ * @see See also `IMPORT_FSTR_DATA_DIGEST`
+ * @note Can only be used at file scope
+ */
+#define IMPORT_FSTR_OBJECT_DIGEST(name, ObjectType, file, digest)                                                      \
+	IMPORT_FSTR_DATA_DIGEST(FSTR_DATA_NAME(name), file, digest)                                                        \
+	extern "C" __attribute__((visibility("hidden"))) const FSTR::ObjectBase FSTR_DATA_NAME(name);                      \
+	DEFINE_FSTR_REF(name, ObjectType, FSTR_DATA_NAME(name));                                                           \
+	FSTR_CATALOGUE_ENTRY(name, FSTR_DATA_NAME(name))
+
+/**
+ * @brief Like IMPORT_FSTR_OBJECT_DIGEST except reference is declared static constexpr
+ */
+#define IMPORT_FSTR_OBJECT_DIGEST_LOCAL(name, ObjectType, file, digest)                                                \
+	IMPORT_FSTR_DATA_DIGEST(FSTR_DATA_NAME(name), file, digest)                                                        \
+	extern "C" __attribute__((visibility("hidden"))) const FSTR::ObjectBase FSTR_DATA_NAME(name);                      \
+	static constexpr DEFINE_FSTR_REF(name, ObjectType, FSTR_DATA_NAME(name));                                          \
+	FSTR_CATALOGUE_ENTRY(name, FSTR_DATA_NAME(name))
 
 namespace FSTR
 {
+/**
+ * @brief Get number of elements in an object data structure at compile time
+ * @param object The data structure, e.g. `FSTR_DATA_NAME(name)`
+ * @see See `FSTR_LENGTH`
+ */
+template <class ObjectData> constexpr size_t constLength(const ObjectData& object)
+{
+	return ObjectBase::decodeLength(object.object.flashLength_) / sizeof(object.data[0]);
+}
+
+/**
+ * @brief Type of elements in an object data structure
+ */
+template <class ObjectData>
+using ObjectDataElement =
+	typename std::remove_cv<typename std::remove_reference<decltype(std::declval<ObjectData>().data[0])>::type>::type;
+
+/**
+ * @brief Get an element from an object data structure at compile time
+ * @param object The data structure
+ * @param index
+ * @see See `FSTR_VALUE_AT`
+ */
+template <class ObjectData>
+constexpr ObjectDataElement<ObjectData> constValueAt(const ObjectData& object, size_t index)
+{
+	return (index < constLength(object)) ? object.data[index] : ObjectDataElement<ObjectData>{};
+}
+
 /**
  * @brief Base class template for all types
  * @tparam ObjectType The object type actually being instantiated
@@ -166,16 +246,16 @@ public:
 		return ObjectBase::length() / sizeof(ElementType);
 	}
 
+	/**
+	 * @brief Find first element matching a value
+	 * @param value
+	 * @retval int Index of element, or -1 if not found
+	 * @note Where elements are 8 or 16-bit integers the data is scanned a word at a time,
+	 * see `findFlash()`. Otherwise each element is read and compared in turn.
+	 */
 	template <typename ValueType> int indexOf(const ValueType& value) const
 	{
-		auto len = length();
-		for(unsigned i = 0; i < len; ++i) {
-			if(as<ObjectType>().valueAt(i) == value) {
-				return i;
-			}
-		}
-
-		return -1;
+		return indexOfValue<ElementType>(value);
 	}
 
 	FSTR_INLINE ElementType valueAt(unsigned index) const
@@ -232,6 +312,75 @@ public:
 		count *= sizeof(ElementType);
 		return ObjectBase::readFlash(offset, buffer, count) / sizeof(ElementType);
 	}
+
+	/**
+	 * @brief Process content in chunks, buffered in RAM
+	 * @tparam BufferSize Size of stack buffer in bytes
+	 * @param callback Invoked as `bool callback(const ElementType* elements, size_t count)`.
+	 * Return true to continue, false to stop.
+	 * @param index First element to process
+	 * @retval size_t Number of elements passed to callback
+	 *
+	 * Avoids the per-element overhead of `valueAt()` when scanning large objects. Example:
+	 *
+	 * 		uint32_t sum = 0;
+	 * 		myArray.forEachChunk([&](const uint16_t* values, size_t count) {
+	 * 			for(unsigned i = 0; i < count; ++i) {
+	 * 				sum += values[i];
+	 * 			}
+	 * 			return true;
+	 * 		});
+	 */
+	template <size_t BufferSize = 64, typename Callback> size_t forEachChunk(Callback callback, size_t index = 0) const
+	{
+		constexpr size_t bufferElements = BufferSize / sizeof(ElementType);
+		static_assert(bufferElements != 0, "forEachChunk BufferSize too small for element");
+		ElementType buffer[bufferElements] FSTR_ALIGNED;
+
+		size_t total = 0;
+		size_t count;
+		while((count = read(index, buffer, bufferElements)) != 0) {
+			total += count;
+			if(!callback(static_cast<const ElementType*>(buffer), count)) {
+				break;
+			}
+			index += count;
+		}
+
+		return total;
+	}
+
+private:
+	template <typename T, typename ValueType>
+	using SwarSearch = std::integral_constant<bool, std::is_integral<T>::value && std::is_integral<ValueType>::value &&
+														(sizeof(T) == 1 || sizeof(T) == 2)>;
+
+	template <typename T, typename ValueType>
+	typename std::enable_if<!SwarSearch<T, ValueType>::value, int>::type indexOfValue(const ValueType& value) const
+	{
+		auto len = length();
+		for(unsigned i = 0; i < len; ++i) {
+			if(as<ObjectType>().valueAt(i) == value) {
+				return i;
+			}
+		}
+
+		return -1;
+	}
+
+	template <typename T, typename ValueType>
+	typename std::enable_if<SwarSearch<T, ValueType>::value, int>::type indexOfValue(const ValueType& value) const
+	{
+		// Value must be representable as an element to match
+		auto element = static_cast<T>(value);
+		if(!(element == value)) {
+			return -1;
+		}
+		if(sizeof(T) == 1) {
+			return findFlash(ObjectBase::data(), length(), uint8_t(element));
+		}
+		return findFlash16(ObjectBase::data(), length(), uint16_t(element));
+	}
 };
 
 } // namespace FSTR
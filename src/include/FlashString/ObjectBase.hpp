@@ -22,9 +22,13 @@
 #pragma once
 
 #include "config.hpp"
+#include "TypeInfo.hpp"
+#include "Stats.hpp"
 
 namespace FSTR
 {
+class Slice;
+
 /**
  * @brief Used when defining data structures
  * @note Should not be used directly, use appropriate Object methods instead
@@ -71,13 +75,23 @@ public:
 	 */
 	size_t read(size_t offset, void* buffer, size_t count) const
 	{
+		Stats::Measure measure(*this, Stats::Event::read);
 		auto len = length();
 		if(offset >= len) {
 			return 0;
 		}
 
 		count = std::min(len - offset, count);
+#if FSTR_RAM_CACHE
+		auto cached = cachedData();
+		if(cached != nullptr) {
+			memcpy(buffer, cached + offset, count);
+			measure.setBytes(count);
+			return count;
+		}
+#endif
 		memcpy_P(buffer, data() + offset, count);
+		measure.setBytes(count);
 		return count;
 	}
 
@@ -97,11 +111,44 @@ public:
 	 */
 	size_t readFlash(size_t offset, void* buffer, size_t count) const;
 
+	/**
+	 * @brief Get a view of a range of bytes within this object
+	 * @param offset Start of range in bytes, truncated to the object length
+	 * @param length Number of bytes, truncated to fit within the object
+	 * @retval Slice Refers to the original object, so copies may be safely discarded
+	 * @note No data is read, so this is cheap enough to use for each HTTP Range request
+	 */
+	Slice slice(size_t offset, size_t length = SIZE_MAX) const;
+
+#if FSTR_RAM_CACHE
+	/**
+	 * @brief Get a pointer to a copy of the object data held by the active `RamCache`
+	 * @retval const uint8_t* nullptr if there is no active cache, or it doesn't hold this object
+	 * @note The object is not loaded into the cache, see `RamCache::add()`
+	 */
+	const uint8_t* cachedData() const;
+#endif
+
 	FSTR_INLINE bool isCopy() const
 	{
 		return (flashLength_ & copyBit) != 0;
 	}
 
+	/**
+	 * @brief Return an empty object which evaluates to null
+	 * @note Used by Maps and Vectors with mixed content, see `Variant`
+	 */
+	static const ObjectBase& empty()
+	{
+		return empty_;
+	}
+
+	/**
+	 * @brief Print content according to the stored type
+	 * @note Uses `Variant`, so objects without type information print as raw String content
+	 */
+	size_t printTo(Print& p) const;
+
 	/**
 	 * @brief Indicates an invalid String, used for return value from lookups, etc.
 	 * @note A real String can be zero-length, but it cannot be null
@@ -111,6 +158,97 @@ public:
 		return flashLength_ == lengthInvalid;
 	}
 
+	/**
+	 * @brief Determine if a hash value is stored with the object
+	 * @see See `DEFINE_FSTR_HASHED`
+	 */
+	bool hasHash() const;
+
+	/**
+	 * @brief Get the stored hash value
+	 * @retval uint32_t Stored value, or 0 if the object has no hash
+	 */
+	uint32_t storedHash() const;
+
+	/**
+	 * @brief Determine if a content digest is stored with the object
+	 * @see See `IMPORT_FSTR_DATA_DIGEST`
+	 */
+	bool hasDigest() const;
+
+	/**
+	 * @brief Get a digest of the object content, suitable for use as an HTTP ETag
+	 * @retval uint32_t FNV-1a hash of the object data, see `Hash::updateDigest()`
+	 * @note If a digest is stored with the object, this requires one word read.
+	 * Otherwise it is calculated by reading the entire object.
+	 */
+	uint32_t digest() const;
+
+	/**
+	 * @brief Calculate a digest of the object content, ignoring any stored value
+	 * @retval uint32_t
+	 * @note Reads the entire object. Used to verify the stored digest, see `Catalogue::check()`.
+	 */
+	uint32_t calculateDigest() const;
+
+	/**
+	 * @brief Get the type of object data
+	 * @retval Type Type::none if the object has no type information
+	 * @see See `FSTR_TYPE_INFO`
+	 */
+	Type type() const;
+
+	/**
+	 * @brief Get the element size stored in the object header
+	 * @retval size_t Size in bytes, or 0 if the object has no type information
+	 * @note For Maps this is the size of the key
+	 */
+	size_t storedElementSize() const;
+
+	/**
+	 * @brief Set in length field of a real object to indicate a hash value precedes it
+	 */
+	static constexpr uint32_t hashBit = 0x40000000U;
+
+	/**
+	 * @brief Set in length field of a real object to indicate it contains type information
+	 */
+	static constexpr uint32_t typeBit = 0x20000000U;
+
+	/**
+	 * @brief Set in length field of a real object to indicate a digest precedes it (or its hash, if present)
+	 */
+	static constexpr uint32_t digestBit = 0x10000000U;
+
+	/**
+	 * @brief Get the value for the length field of an object, including type information if enabled
+	 * @param length Length of object data in bytes
+	 * @param type Type of object data
+	 * @param elementSize Size of each element in bytes
+	 * @retval uint32_t
+	 * @note Type information cannot be stored for objects of 1MB or more, or with elements larger than 8 bytes.
+	 * Such objects are stored without it.
+	 */
+	static constexpr uint32_t typedLength(size_t length, Type type, size_t elementSize)
+	{
+		return (FSTR_TYPE_INFO == 0 || type == Type::none || length > typeLengthMask || elementSize == 0 ||
+				elementSize > 8)
+				   ? length
+				   : length | typeBit | ((elementSize - 1) << typeSizeShift) |
+						 (uint32_t(type) << typeShift);
+	}
+
+	/**
+	 * @brief Get the data length from the length field of a real (non-copy) object
+	 * @param flashLength Value of length field
+	 * @retval size_t Length of object data in bytes
+	 * @note Used by `FSTR_LENGTH` to obtain the length at compile time
+	 */
+	static constexpr size_t decodeLength(uint32_t flashLength)
+	{
+		return (flashLength & typeBit) ? (flashLength & typeLengthMask) : (flashLength & ~(hashBit | digestBit));
+	}
+
 	/* Member data must be public for initialisation to work but DO NOT ACCESS DIRECTLY !! */
 
 	uint32_t flashLength_;
@@ -137,8 +275,11 @@ protected:
 	}
 
 private:
-	static constexpr uint32_t copyBit = 0x80000000U;	   ///< Set to indicate copy
-	static constexpr uint32_t lengthInvalid = copyBit | 0; ///< Indicates null string in a copy
+	static constexpr uint32_t copyBit = 0x80000000U;		///< Set to indicate copy
+	static constexpr uint32_t lengthInvalid = copyBit | 0;	///< Indicates null string in a copy
+	static constexpr uint32_t typeLengthMask = 0x000FFFFFU; ///< Length field when typeBit set
+	static constexpr unsigned typeSizeShift = 20;			///< 3 bits: elementSize - 1
+	static constexpr unsigned typeShift = 23;				///< 5 bits: Type
 };
 
 } // namespace FSTR
@@ -25,14 +25,22 @@
 
 namespace FSTR
 {
+/**
+ * @brief Random-access iterator for Objects and similar containers
+ * @note Elements are read on dereference, so `operator*` returns a copy for non-pointer types.
+ * Compatible with algorithms such as `std::lower_bound`.
+ */
 template <class ObjectType, typename ElementType>
 class ObjectIterator : public std::iterator<std::random_access_iterator_tag, ElementType>
 {
 public:
+	using difference_type = ptrdiff_t;
+
 	ObjectIterator() = default;
 	ObjectIterator(const ObjectIterator&) = default;
+	ObjectIterator& operator=(const ObjectIterator&) = default;
 
-	ObjectIterator(const ObjectType& object, unsigned index) : object(object), index(index)
+	ObjectIterator(const ObjectType& object, unsigned index) : object(&object), index(index)
 	{
 	}
 
@@ -49,13 +57,51 @@ public:
 		return tmp;
 	}
 
-	ObjectIterator operator+=(size_t distance)
+	ObjectIterator& operator--()
+	{
+		--index;
+		return *this;
+	}
+
+	ObjectIterator operator--(int)
 	{
 		ObjectIterator tmp(*this);
-		index += distance;
+		--index;
 		return tmp;
 	}
 
+	ObjectIterator& operator+=(difference_type distance)
+	{
+		index += distance;
+		return *this;
+	}
+
+	ObjectIterator& operator-=(difference_type distance)
+	{
+		index -= distance;
+		return *this;
+	}
+
+	ObjectIterator operator+(difference_type distance) const
+	{
+		return ObjectIterator(*object, index + distance);
+	}
+
+	friend ObjectIterator operator+(difference_type distance, const ObjectIterator& it)
+	{
+		return it + distance;
+	}
+
+	ObjectIterator operator-(difference_type distance) const
+	{
+		return ObjectIterator(*object, index - distance);
+	}
+
+	difference_type operator-(const ObjectIterator& rhs) const
+	{
+		return difference_type(index) - difference_type(rhs.index);
+	}
+
 	bool operator==(const ObjectIterator& rhs) const
 	{
 		return index == rhs.index;
@@ -66,13 +112,33 @@ public:
 		return index != rhs.index;
 	}
 
+	bool operator<(const ObjectIterator& rhs) const
+	{
+		return index < rhs.index;
+	}
+
+	bool operator>(const ObjectIterator& rhs) const
+	{
+		return index > rhs.index;
+	}
+
+	bool operator<=(const ObjectIterator& rhs) const
+	{
+		return index <= rhs.index;
+	}
+
+	bool operator>=(const ObjectIterator& rhs) const
+	{
+		return index >= rhs.index;
+	}
+
 	/**
 	 * @brief Accessor returns a copy for non-pointer-type elements
 	 */
 	template <typename T = ElementType>
 	typename std::enable_if<!std::is_pointer<T>::value, const ElementType>::type operator*() const
 	{
-		return object.valueAt(index);
+		return object->valueAt(index);
 	}
 
 	/**
@@ -82,11 +148,29 @@ public:
 	typename std::enable_if<std::is_pointer<T>::value, const typename std::remove_pointer<ElementType>::type&>::type
 	operator*() const
 	{
-		return object.valueAt(index);
+		return object->valueAt(index);
+	}
+
+	/**
+	 * @brief Offset accessor
+	 */
+	typename std::conditional<std::is_pointer<ElementType>::value,
+							  const typename std::remove_pointer<ElementType>::type&, const ElementType>::type
+	operator[](difference_type distance) const
+	{
+		return *(*this + distance);
+	}
+
+	/**
+	 * @brief Get index of the element this iterator refers to
+	 */
+	unsigned getIndex() const
+	{
+		return index;
 	}
 
 private:
-	const ObjectType& object;
+	const ObjectType* object = nullptr;
 	unsigned index = 0;
 };
 
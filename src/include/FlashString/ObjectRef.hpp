@@ -0,0 +1,158 @@
+/****
+ * ObjectRef.hpp - Lightweight resolved view of an Object
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#pragma once
+
+#include "Object.hpp"
+#include "ArrayPrinter.hpp"
+#include <esp_spi_flash.h>
+
+namespace FSTR
+{
+class String;
+
+/**
+ * @brief Provides fast access to the content of a String or Array
+ * @ingroup fstr_object
+ * @tparam ObjectType
+ *
+ * Each call to `Object::length()` or `Object::data()` has to check whether the object is null
+ * or a copy, and if so follow the pointer to the real object. This class does that once,
+ * on construction, so element access only requires a bounds check.
+ *
+ * Example:
+ *
+ * 		FSTR::Array<uint16_t> arr = getSomeArray(); // A copy
+ * 		FSTR::ObjectRef<FSTR::Array<uint16_t>> ref(arr);
+ * 		for(auto v : ref) {
+ * 			...
+ * 		}
+ *
+ * @note The object being referred to must remain in scope. For a copy, that's the copy itself.
+ */
+template <class ObjectType> class ObjectRef
+{
+public:
+	using ElementType = typename ObjectType::Iterator::value_type;
+	using Iterator = ObjectIterator<ObjectRef, ElementType>;
+
+	ObjectRef(const ObjectType& object)
+		: object(object), ptr(reinterpret_cast<const ElementType*>(object.ObjectBase::data())), len(object.length())
+	{
+	}
+
+	Iterator begin() const
+	{
+		return Iterator(*this, 0);
+	}
+
+	Iterator end() const
+	{
+		return Iterator(*this, len);
+	}
+
+	/**
+	 * @brief Get the length of the content in elements
+	 */
+	FSTR_INLINE size_t length() const
+	{
+		return len;
+	}
+
+	/**
+	 * @brief Get a pointer to the flash data
+	 */
+	FSTR_INLINE const ElementType* data() const
+	{
+		return ptr;
+	}
+
+	FSTR_INLINE ElementType valueAt(unsigned index) const
+	{
+		return (index < len) ? readValue(ptr + index) : ElementType{};
+	}
+
+	FSTR_INLINE ElementType operator[](unsigned index) const
+	{
+		return valueAt(index);
+	}
+
+	/**
+	 * @brief Read content into RAM
+	 * @see See `Object::read()`
+	 */
+	size_t read(size_t index, ElementType* buffer, size_t count) const
+	{
+		if(index >= len) {
+			return 0;
+		}
+
+		count = std::min(len - index, count);
+		memcpy_P(buffer, ptr + index, count * sizeof(ElementType));
+		return count;
+	}
+
+	/**
+	 * @brief Read content into RAM, using `flashmem_read()`
+	 * @see See `Object::readFlash()`
+	 */
+	size_t readFlash(size_t index, ElementType* buffer, size_t count) const
+	{
+		if(index >= len) {
+			return 0;
+		}
+
+		count = std::min(len - index, count);
+		auto addr = flashmem_get_address(ptr + index);
+		return flashmem_read(buffer, addr, count * sizeof(ElementType)) / sizeof(ElementType);
+	}
+
+	/**
+	 * @brief Get the object being referred to
+	 */
+	const ObjectType& getObject() const
+	{
+		return object;
+	}
+
+	/**
+	 * @brief Print a String
+	 */
+	template <typename T = ObjectType>
+	typename std::enable_if<std::is_same<T, String>::value, size_t>::type printTo(Print& p) const
+	{
+		return object.printTo(p);
+	}
+
+	/**
+	 * @brief Print array content
+	 */
+	template <typename T = ObjectType>
+	typename std::enable_if<!std::is_same<T, String>::value, size_t>::type printTo(Print& p) const
+	{
+		return ArrayPrinter<ObjectRef>(*this).printTo(p);
+	}
+
+private:
+	const ObjectType& object;
+	const ElementType* ptr;
+	size_t len;
+};
+
+} // namespace FSTR
@@ -0,0 +1,290 @@
+/****
+ * PackedArray.hpp - Integer arrays stored using variable-width delta encoding
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#pragma once
+
+#include "Object.hpp"
+
+/**
+ * @defgroup fstr_packed Packed arrays
+ * @ingroup FlashString
+ * @{
+ */
+
+/**
+ * @brief Declare a global PackedArray& reference
+ * @param name
+ * @param ElementType
+ * @note Use IMPORT_FSTR_PACKED_ARRAY to instantiate the global object
+ */
+#define DECLARE_FSTR_PACKED_ARRAY(name, ElementType) DECLARE_FSTR_OBJECT(name, FSTR::PackedArray<ElementType>)
+
+/**
+ * @brief Import a packed array with reference
+ * @param name Name for the object
+ * @param ElementType Integral type, must match the `--type` given to `tools/fstr-pack.py`
+ * @param file Absolute path to the file, as generated by `tools/fstr-pack.py`
+ * @note Can only be used at file scope
+ */
+#define IMPORT_FSTR_PACKED_ARRAY(name, ElementType, file)                                                              \
+	IMPORT_FSTR_OBJECT(name, FSTR::PackedArray<ElementType>, file)
+
+/**
+ * @brief Like IMPORT_FSTR_PACKED_ARRAY except reference is declared static constexpr
+ */
+#define IMPORT_FSTR_PACKED_ARRAY_LOCAL(name, ElementType, file)                                                        \
+	IMPORT_FSTR_OBJECT_LOCAL(name, FSTR::PackedArray<ElementType>, file)
+
+namespace FSTR
+{
+/**
+ * @brief Header at start of PackedArray object data
+ */
+struct PackedArrayHeader {
+	static constexpr uint8_t flagSigned = 0x01;
+
+	uint32_t count;		 ///< Number of elements
+	uint8_t elementSize; ///< Size of each element when decoded
+	uint8_t flags;
+	uint16_t blockSize; ///< Number of elements in each block
+	// uint32_t offsets[]: Position of each block relative to start of encoded values
+	// uint8_t values[]
+};
+
+static_assert(sizeof(PackedArrayHeader) == 8, "PackedArrayHeader size incorrect");
+
+/**
+ * @brief Decodes values sequentially from a PackedArray
+ * @note Used internally by PackedArray
+ */
+class PackedDecoder
+{
+public:
+	PackedDecoder() = default;
+
+	/**
+	 * @brief Position decoder at start of a block
+	 * @param object The PackedArray
+	 * @param block Index of block
+	 * @retval bool false if the object or block is invalid
+	 */
+	bool seek(const ObjectBase& object, unsigned block);
+
+	/**
+	 * @brief Decode the next value
+	 * @note Caller must not read beyond the end of a block without calling seek()
+	 */
+	uint64_t next();
+
+private:
+	uint8_t nextByte()
+	{
+		if(bufPos == bufLength) {
+			fill();
+		}
+		return buffer[bufPos++];
+	}
+
+	void fill();
+
+	const ObjectBase* object = nullptr;
+	size_t offset = 0; ///< Position in object of next data to buffer
+	uint64_t value = 0;
+	uint8_t buffer[32];
+	uint8_t bufPos = 0;
+	uint8_t bufLength = 0;
+};
+
+/**
+ * @brief An array of integers stored using delta and variable-width encoding
+ * @tparam ElementType
+ *
+ * Files are prepared using `tools/fstr-pack.py` and imported using `IMPORT_FSTR_PACKED_ARRAY`.
+ * This is effective for tables of timestamps or IDs, where consecutive values differ by small amounts.
+ *
+ * Values are split into blocks, with an offset table to locate each one. `valueAt()` decodes
+ * from the start of the containing block, so takes at most `blockSize` steps.
+ * Iterating through the array, or reading a range using `read()`, decodes each value once.
+ *
+ * `Object` methods not listed here, such as `readFlash()`, operate on the encoded data.
+ */
+template <typename ElementType> class PackedArray : public Object<PackedArray<ElementType>, uint8_t>
+{
+	static_assert(std::is_integral<ElementType>::value && sizeof(ElementType) <= 8,
+				  "PackedArray must contain integral values");
+
+public:
+	/**
+	 * @brief Forward iterator which decodes values sequentially
+	 */
+	class Iterator : public std::iterator<std::forward_iterator_tag, ElementType>
+	{
+	public:
+		Iterator(const PackedArray& array, unsigned index) : array_(&array), index(index)
+		{
+			auto hdr = array.header();
+			blockSize = hdr.blockSize;
+			count = hdr.count;
+			if(index < count && decoder.seek(array, index / blockSize)) {
+				value = decoder.next();
+				for(unsigned i = index % blockSize; i != 0; --i) {
+					value = decoder.next();
+				}
+			}
+		}
+
+		Iterator& operator++()
+		{
+			++index;
+			if(index < count) {
+				if(index % blockSize == 0) {
+					decoder.seek(*array_, index / blockSize);
+				}
+				value = decoder.next();
+			}
+			return *this;
+		}
+
+		Iterator operator++(int)
+		{
+			Iterator tmp(*this);
+			++*this;
+			return tmp;
+		}
+
+		bool operator==(const Iterator& rhs) const
+		{
+			return index == rhs.index;
+		}
+
+		bool operator!=(const Iterator& rhs) const
+		{
+			return index != rhs.index;
+		}
+
+		ElementType operator*() const
+		{
+			return ElementType(value);
+		}
+
+	private:
+		const PackedArray* array_;
+		PackedDecoder decoder;
+		uint64_t value = 0;
+		unsigned index;
+		unsigned count = 0;
+		uint16_t blockSize = 0;
+	};
+
+	/**
+	 * @brief Get the header information
+	 * @retval PackedArrayHeader count is 0 if the object is invalid or its element size doesn't match
+	 */
+	PackedArrayHeader header() const
+	{
+		PackedArrayHeader hdr{};
+		if(ObjectBase::read(0, &hdr, sizeof(hdr)) != sizeof(hdr) || hdr.elementSize != sizeof(ElementType) ||
+		   hdr.blockSize == 0) {
+			hdr = PackedArrayHeader{};
+		}
+		return hdr;
+	}
+
+	/**
+	 * @brief Get the number of elements
+	 */
+	size_t length() const
+	{
+		return header().count;
+	}
+
+	/**
+	 * @brief Get the number of elements in each block
+	 */
+	size_t blockSize() const
+	{
+		return header().blockSize;
+	}
+
+	/**
+	 * @brief Get a value
+	 * @param index
+	 * @retval ElementType 0 if index is out of range
+	 */
+	ElementType valueAt(unsigned index) const
+	{
+		return *Iterator(*this, index);
+	}
+
+	ElementType operator[](unsigned index) const
+	{
+		return valueAt(index);
+	}
+
+	Iterator begin() const
+	{
+		return Iterator(*this, 0);
+	}
+
+	Iterator end() const
+	{
+		return Iterator(*this, length());
+	}
+
+	/**
+	 * @brief Decode values into RAM
+	 * @param index First element to read
+	 * @param buffer Where to store data
+	 * @param count How many elements to read
+	 * @retval size_t Number of elements actually read
+	 */
+	size_t read(size_t index, ElementType* buffer, size_t count) const
+	{
+		auto len = length();
+		if(index >= len) {
+			return 0;
+		}
+		count = std::min(count, len - index);
+		Iterator it(*this, index);
+		for(unsigned i = 0; i < count; ++i, ++it) {
+			buffer[i] = *it;
+		}
+		return count;
+	}
+
+	/**
+	 * @brief Find first element matching a value
+	 * @retval int Index of element, or -1 if not found
+	 */
+	int indexOf(ElementType value) const
+	{
+		int index = 0;
+		for(auto v : *this) {
+			if(v == value) {
+				return index;
+			}
+			++index;
+		}
+		return -1;
+	}
+};
+
+} // namespace FSTR
+
+/** @} */
@@ -0,0 +1,253 @@
+/****
+ * PrefixVector.hpp - Vector of Strings with a sorted index for prefix matching
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#pragma once
+
+#include "String.hpp"
+#include "Array.hpp"
+#include "Vector.hpp"
+
+/**
+ * @addtogroup fstr_vector
+ * @{
+ */
+
+/**
+ * @brief Declare a global PrefixVector& reference
+ * @param name
+ * @note Use DEFINE_FSTR_VECTOR_PREFIXED to instantiate the global object
+ */
+#define DECLARE_FSTR_VECTOR_PREFIXED(name) DECLARE_FSTR_OBJECT(name, FSTR::PrefixVector)
+
+/**
+ * @brief Define a PrefixVector Object with global reference
+ * @param name Name of PrefixVector& reference to define
+ * @param order Pointer to sort index, an `Array<uint16_t>`
+ * @param ... List of String* pointers
+ * @note Use `tools/fstr-prefix.py` to generate the definition
+ */
+#define DEFINE_FSTR_VECTOR_PREFIXED(name, order, ...)                                                                  \
+	static DEFINE_FSTR_VECTOR_DATA_PREFIXED(FSTR_DATA_NAME(name), order, __VA_ARGS__);                                 \
+	DEFINE_FSTR_REF_NAMED(name, FSTR::PrefixVector);
+
+/**
+ * @brief Like DEFINE_FSTR_VECTOR_PREFIXED except reference is declared static constexpr
+ */
+#define DEFINE_FSTR_VECTOR_PREFIXED_LOCAL(name, order, ...)                                                            \
+	static DEFINE_FSTR_VECTOR_DATA_PREFIXED(FSTR_DATA_NAME(name), order, __VA_ARGS__);                                 \
+	static constexpr DEFINE_FSTR_REF_NAMED(name, FSTR::PrefixVector);
+
+/**
+ * @brief Define a PrefixVector data structure
+ * @param name Name of data structure
+ * @param order Pointer to sort index
+ * @param ... List of String* pointers
+ * @note The index pointer follows the Vector entries, but is not included in the object length
+ */
+#define DEFINE_FSTR_VECTOR_DATA_PREFIXED(name, order, ...)                                                             \
+	constexpr const struct {                                                                                           \
+		FSTR::ObjectBase object;                                                                                       \
+		const FSTR::String* data[sizeof((const void*[]){__VA_ARGS__}) / sizeof(void*)];                                \
+		const FSTR::Array<uint16_t>* index;                                                                            \
+	} FSTR_PACKED FSTR_ALIGNED name PROGMEM = {                                                                        \
+		{FSTR::ObjectBase::typedLength(sizeof(name.data), FSTR::Type::vector, sizeof(void*))}, {__VA_ARGS__}, order};  \
+	FSTR_CHECK_STRUCT(name);
+
+namespace FSTR
+{
+class PrefixVector;
+
+/**
+ * @brief A set of PrefixVector entries which start with a given prefix
+ *
+ * Entries are in sort order, ignoring case. Example:
+ *
+ * 		for(auto& cmd : commands.startsWith("he")) {
+ * 			Serial.println(cmd);
+ * 		}
+ */
+class PrefixMatch
+{
+public:
+	class Iterator : public std::iterator<std::forward_iterator_tag, const String>
+	{
+	public:
+		Iterator(const PrefixMatch& match, unsigned pos) : match(&match), pos(pos)
+		{
+		}
+
+		Iterator& operator++()
+		{
+			++pos;
+			return *this;
+		}
+
+		bool operator==(const Iterator& rhs) const
+		{
+			return pos == rhs.pos;
+		}
+
+		bool operator!=(const Iterator& rhs) const
+		{
+			return pos != rhs.pos;
+		}
+
+		const String& operator*() const
+		{
+			return (*match)[pos];
+		}
+
+	private:
+		const PrefixMatch* match;
+		unsigned pos;
+	};
+
+	PrefixMatch(const PrefixVector& vector, unsigned first, unsigned last)
+		: vector(vector), first(first), last(last)
+	{
+	}
+
+	/**
+	 * @brief Get the number of matching entries
+	 */
+	unsigned length() const
+	{
+		return last - first;
+	}
+
+	/**
+	 * @brief Get index of a matching entry in the vector
+	 * @param pos Position within this match, from 0 to `length() - 1`
+	 * @retval int -1 if pos is out of range
+	 */
+	int indexAt(unsigned pos) const;
+
+	/**
+	 * @brief Get a matching entry
+	 * @param pos Position within this match
+	 */
+	const String& operator[](unsigned pos) const;
+
+	Iterator begin() const
+	{
+		return Iterator(*this, 0);
+	}
+
+	Iterator end() const
+	{
+		return Iterator(*this, length());
+	}
+
+private:
+	const PrefixVector& vector;
+	unsigned first; ///< Position of first match in sort index
+	unsigned last;  ///< Position following last match
+};
+
+/**
+ * @brief A Vector of Strings with an index for prefix matching
+ *
+ * The index holds the Vector entries in sorted order, ignoring case. It is generated at build time
+ * by `tools/fstr-prefix.py`. Entries starting with a given prefix are adjacent in the index, so are
+ * located using a binary search on each character of the prefix.
+ *
+ * A prefix lookup therefore takes a number of single-character reads proportional to
+ * `prefixLength * log2(length())`, instead of comparing every entry.
+ *
+ * All comparisons ignore case.
+ */
+class PrefixVector : public Vector<String>
+{
+public:
+	/**
+	 * @brief Find all entries which start with the given prefix
+	 * @param prefix
+	 * @param length Length of prefix, if 0 prefix is nul-terminated
+	 */
+	PrefixMatch startsWith(const char* prefix, size_t length = 0) const;
+
+	PrefixMatch startsWith(const WString& prefix) const
+	{
+		return startsWith(prefix.c_str(), prefix.length());
+	}
+
+	/**
+	 * @brief Find an entry starting with the given prefix
+	 * @param prefix
+	 * @param length Length of prefix, if 0 prefix is nul-terminated
+	 * @retval int Index of first entry (in sort order) which starts with prefix, or -1 if none match
+	 * @note If the prefix is an entry, that entry is returned
+	 */
+	int findPrefix(const char* prefix, size_t length = 0) const
+	{
+		auto match = startsWith(prefix, length);
+		return match.indexAt(0);
+	}
+
+	int findPrefix(const WString& prefix) const
+	{
+		return findPrefix(prefix.c_str(), prefix.length());
+	}
+
+	/**
+	 * @brief Find the longest entry which is a prefix of the given text
+	 * @param text For example, a URL path or command line
+	 * @param length Length of text, if 0 text is nul-terminated
+	 * @retval int Index of longest matching entry, or -1 if none match
+	 */
+	int longestMatch(const char* text, size_t length = 0) const;
+
+	int longestMatch(const WString& text) const
+	{
+		return longestMatch(text.c_str(), text.length());
+	}
+
+	/**
+	 * @brief Get index of an entry in the vector from its position in sort order
+	 * @param pos
+	 * @retval int -1 if pos is out of range
+	 */
+	int indexAt(unsigned pos) const
+	{
+		return (pos < indexLength()) ? index()[pos] : -1;
+	}
+
+private:
+	friend class PrefixMatch;
+
+	const Array<uint16_t>& index() const
+	{
+		return **reinterpret_cast<const Array<uint16_t>* const*>(data() + length());
+	}
+
+	size_t indexLength() const
+	{
+		return std::min(index().length(), length());
+	}
+
+	/*
+	 * Given the range [first, last) of entries which all match the first `pos` characters,
+	 * reduce it to those which also have `c` at `pos`
+	 */
+	void narrow(unsigned& first, unsigned& last, unsigned pos, char c, Stats::Measure& measure) const;
+};
+
+} // namespace FSTR
+
+/** @} */
@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include "config.hpp"
 #include <Print.h>
 
 /**
@@ -68,6 +69,95 @@ template <typename T> size_t println(Print& p, T value)
 	return size;
 }
 
+/**
+ * @brief Options for printing Arrays, Vectors and Maps
+ *
+ * Null values use the default for the object type.
+ *
+ * Example:
+ *
+ * 		FSTR::PrintFormat format;
+ * 		format.separator = "; ";
+ * 		format.base = HEX;
+ * 		myArray.printTo(Serial, format);
+ *
+ * @note Strings must remain valid while printing
+ */
+struct PrintFormat {
+	const char* prefix = nullptr;	///< Printed before first element
+	const char* separator = nullptr; ///< Printed between elements
+	const char* suffix = nullptr;	///< Printed after last element
+	uint8_t base = DEC;				 ///< Number base for integral elements, except char
+};
+
+/**
+ * @brief Collects output into a buffer so it can be written in large blocks
+ * @tparam BufferSize
+ *
+ * Used by printer classes to avoid many small writes to the output.
+ * Content is written when the buffer is full, and on destruction.
+ *
+ * @note Because output is deferred, `write()` return values indicate the amount of data buffered.
+ * The value returned by `flush()` gives the amount actually accepted by the output.
+ */
+template <size_t BufferSize> class BufferedPrint : public Print
+{
+public:
+	BufferedPrint(Print& out) : out(out)
+	{
+	}
+
+	~BufferedPrint()
+	{
+		flush();
+	}
+
+	size_t write(uint8_t c) override
+	{
+		if(length == BufferSize) {
+			flush();
+		}
+		buffer[length++] = c;
+		return 1;
+	}
+
+	size_t write(const uint8_t* data, size_t size) override
+	{
+		if(size > BufferSize - length) {
+			flush();
+			if(size >= BufferSize) {
+				auto n = out.write(data, size);
+				written += n;
+				return n;
+			}
+		}
+		memcpy(&buffer[length], data, size);
+		length += size;
+		return size;
+	}
+
+	using Print::write;
+
+	/**
+	 * @brief Write any buffered content to the output
+	 * @retval size_t Total number of bytes accepted by the output so far
+	 */
+	size_t flush()
+	{
+		if(length != 0) {
+			written += out.write(buffer, length);
+			length = 0;
+		}
+		return written;
+	}
+
+private:
+	Print& out;
+	uint8_t buffer[BufferSize];
+	size_t length = 0;
+	size_t written = 0;
+};
+
 } // namespace FSTR
 
 /** @} */
@@ -0,0 +1,218 @@
+/****
+ * RamCache.hpp - Keep copies of frequently used objects in RAM
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#pragma once
+
+#include "ObjectBase.hpp"
+
+namespace FSTR
+{
+/**
+ * @brief Holds RAM copies of small objects within a fixed heap budget
+ * @ingroup fstr_object
+ *
+ * Objects are copied from flash by `add()`, or by `get()` if no larger than `maxObjectSize`,
+ * and evicted least-recently-used first when the budget would be exceeded.
+ * Other accesses only use objects which are already loaded, so reading through
+ * many objects once doesn't displace the ones which are used often.
+ *
+ * Example:
+ *
+ * 		FSTR::RamCache cache(2048);
+ * 		cache.add(myMap);
+ * 		auto data = cache.get(myString);
+ *
+ * Build with `FSTR_RAM_CACHE=1` and call `setActive()` to have `ObjectBase::read()`,
+ * `ObjectBase::readFlash()`, String comparisons and Map lookups use any loaded copy.
+ * Pointers returned by `ObjectBase::data()` always refer to flash.
+ *
+ * Use `FSTR::Stats` to identify which objects are worth adding.
+ *
+ * @note Not thread-safe
+ */
+class RamCache
+{
+public:
+	/**
+	 * @brief Construct a cache
+	 * @param budget Maximum number of bytes of heap to use, including overheads
+	 * @param maxObjectSize Largest object which `get()` will load
+	 */
+	RamCache(size_t budget, size_t maxObjectSize = 256) : budget(budget), maxObjectSize(maxObjectSize)
+	{
+	}
+
+	~RamCache();
+
+	RamCache(const RamCache&) = delete;
+	RamCache& operator=(const RamCache&) = delete;
+
+	/**
+	 * @brief Get a RAM copy of an object's data, loading it if necessary
+	 * @param object
+	 * @retval const uint8_t* nullptr if object is too large or cannot be loaded
+	 */
+	const uint8_t* get(const ObjectBase& object);
+
+	/**
+	 * @brief Get a RAM copy of an object's data if it is already loaded
+	 * @param object
+	 * @retval const uint8_t* nullptr if not loaded
+	 * @note Does not affect eviction order
+	 */
+	const uint8_t* find(const ObjectBase& object) const;
+
+	/**
+	 * @brief Get a RAM copy of an object's data if it is already loaded, marking it as recently used
+	 * @param object
+	 * @retval const uint8_t* nullptr if not loaded
+	 * @note Objects are never loaded, and a failed lookup is not counted as a miss
+	 */
+	const uint8_t* lookup(const ObjectBase& object);
+
+	/**
+	 * @brief Load an object into the cache regardless of `maxObjectSize`
+	 * @param object
+	 * @retval bool false if the object doesn't fit within the budget
+	 */
+	bool add(const ObjectBase& object)
+	{
+		return load(object) != nullptr;
+	}
+
+	/**
+	 * @brief Remove an object from the cache
+	 * @param object
+	 * @retval bool true if object was loaded
+	 */
+	bool remove(const ObjectBase& object);
+
+	/**
+	 * @brief Remove all objects from the cache
+	 */
+	void clear();
+
+	/**
+	 * @brief Read object content via the cache
+	 * @param object
+	 * @param offset
+	 * @param buffer
+	 * @param count
+	 * @retval size_t Number of bytes read
+	 * @note Reads directly from flash if the object is not loaded
+	 */
+	size_t read(const ObjectBase& object, size_t offset, void* buffer, size_t count);
+
+	/**
+	 * @brief Get the number of bytes of heap in use
+	 */
+	size_t used() const
+	{
+		return usedBytes;
+	}
+
+	/**
+	 * @brief Get the maximum number of bytes of heap which may be used
+	 */
+	size_t getBudget() const
+	{
+		return budget;
+	}
+
+	/**
+	 * @brief Get the number of objects in the cache
+	 */
+	unsigned count() const
+	{
+		return entryCount;
+	}
+
+	/**
+	 * @brief Number of calls to `get()` or `lookup()` satisfied from RAM
+	 */
+	unsigned hits() const
+	{
+		return hitCount;
+	}
+
+	/**
+	 * @brief Number of calls to `get()` which required a flash read, or were not cached
+	 */
+	unsigned misses() const
+	{
+		return missCount;
+	}
+
+	/**
+	 * @brief Set the cache used by `ObjectBase::read()` and `ObjectBase::readFlash()`
+	 * @param cache nullptr to stop using a cache
+	 * @note Has no effect unless built with `FSTR_RAM_CACHE=1`
+	 */
+	static void setActive(RamCache* cache)
+	{
+		active = cache;
+	}
+
+	/**
+	 * @brief Get the cache used by `ObjectBase::read()` and `ObjectBase::readFlash()`
+	 */
+	static RamCache* getActive()
+	{
+		return active;
+	}
+
+private:
+	struct Entry {
+		Entry* prev;
+		Entry* next;
+		const uint8_t* flashData; ///< Identifies the object
+		size_t length;
+
+		uint8_t* data()
+		{
+			return reinterpret_cast<uint8_t*>(this + 1);
+		}
+	};
+
+	static size_t entrySize(size_t length)
+	{
+		return sizeof(Entry) + ALIGNUP4(length);
+	}
+
+	Entry* findEntry(const ObjectBase& object) const;
+	const uint8_t* load(const ObjectBase& object);
+	bool evict(size_t required);
+	void pushFront(Entry* entry);
+	void unlink(Entry* entry);
+	void release(Entry* entry);
+
+	static RamCache* active;
+
+	size_t budget;
+	size_t maxObjectSize;
+	size_t usedBytes = 0;
+	size_t maxLength = 0;  ///< No entry is longer than this, so larger objects needn't be looked up
+	Entry* head = nullptr; ///< Most recently used
+	Entry* tail = nullptr; ///< Least recently used
+	unsigned entryCount = 0;
+	unsigned hitCount = 0;
+	unsigned missCount = 0;
+};
+
+} // namespace FSTR
@@ -0,0 +1,173 @@
+/****
+ * Slice.hpp - Non-owning view of a range within an object
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#pragma once
+
+#include "ObjectBase.hpp"
+
+class Print;
+
+namespace FSTR
+{
+class StringPrinter;
+
+/**
+ * @brief A range of bytes within an object
+ * @ingroup fstr_object
+ *
+ * This is a lightweight reference to the object, so creating one doesn't access any data.
+ * Use `ObjectBase::slice()` to create a slice:
+ *
+ * 		auto range = largeFile.slice(request.rangeStart, request.rangeLength);
+ * 		auto stream = new FSTR::Stream(range);
+ *
+ * Offsets are always in bytes, regardless of the type of object.
+ */
+class Slice
+{
+public:
+	/**
+	 * @brief Construct a slice of an object
+	 * @param object The object must remain valid for the life of the slice
+	 * @param offset Start of range, truncated to the object length
+	 * @param length Number of bytes, truncated to fit within the object
+	 */
+	Slice(const ObjectBase& object, size_t offset = 0, size_t length = SIZE_MAX) : object_(&object)
+	{
+		auto objectLength = object.length();
+		offset_ = std::min(offset, objectLength);
+		length_ = std::min(length, objectLength - offset_);
+	}
+
+	/**
+	 * @brief Get the object containing this slice
+	 */
+	const ObjectBase& object() const
+	{
+		return *object_;
+	}
+
+	/**
+	 * @brief Get offset of this slice within the object, in bytes
+	 */
+	size_t offset() const
+	{
+		return offset_;
+	}
+
+	/**
+	 * @brief Get the length of this slice in bytes
+	 */
+	size_t length() const
+	{
+		return length_;
+	}
+
+	/**
+	 * @brief Get a pointer to the flash data for this slice
+	 * @note The pointer may not be word-aligned
+	 */
+	const uint8_t* data() const
+	{
+		return object_->data() + offset_;
+	}
+
+	/**
+	 * @brief Get a range within this slice
+	 * @param offset Relative to start of this slice
+	 * @param length
+	 */
+	Slice slice(size_t offset, size_t length = SIZE_MAX) const
+	{
+		offset = std::min(offset, length_);
+		return Slice(*object_, offset_ + offset, std::min(length, length_ - offset));
+	}
+
+	/**
+	 * @brief Read content into RAM
+	 * @param offset Relative to start of this slice
+	 * @param buffer
+	 * @param count
+	 * @retval size_t Number of bytes actually read
+	 * @see See `ObjectBase::read()`
+	 */
+	size_t read(size_t offset, void* buffer, size_t count) const
+	{
+		return (offset >= length_) ? 0 : object_->read(offset_ + offset, buffer, std::min(count, length_ - offset));
+	}
+
+	/**
+	 * @brief Read content into RAM using `flashmem_read()`
+	 * @see See `ObjectBase::readFlash()`
+	 */
+	size_t readFlash(size_t offset, void* buffer, size_t count) const
+	{
+		return (offset >= length_) ? 0
+								   : object_->readFlash(offset_ + offset, buffer, std::min(count, length_ - offset));
+	}
+
+	/**
+	 * @brief Compare content with a block of data in RAM
+	 * @param data
+	 * @param length If 0, data is assumed to be a nul-terminated string
+	 */
+	bool equals(const char* data, size_t length = 0) const;
+
+	/**
+	 * @brief Compare content with another slice
+	 */
+	bool equals(const Slice& other) const;
+
+	bool operator==(const char* str) const
+	{
+		return equals(str);
+	}
+
+	bool operator==(const Slice& other) const
+	{
+		return equals(other);
+	}
+
+	bool operator!=(const char* str) const
+	{
+		return !equals(str);
+	}
+
+	bool operator!=(const Slice& other) const
+	{
+		return !equals(other);
+	}
+
+	/**
+	 * @brief Get a printer for this slice
+	 * @see See `String::printer()`
+	 */
+	StringPrinter printer() const;
+
+	StringPrinter printer(char* buffer, size_t bufferSize) const;
+
+	size_t printTo(Print& p) const;
+
+private:
+	const ObjectBase* object_;
+	size_t offset_;
+	size_t length_;
+};
+
+} // namespace FSTR
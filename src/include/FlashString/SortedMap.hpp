@@ -0,0 +1,210 @@
+/****
+ * SortedMap.hpp - Defines the SortedMap class template and associated macros
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#pragma once
+
+#include "Map.hpp"
+
+/**
+ * @addtogroup fstr_map
+ * @{
+ */
+
+/**
+ * @brief Declare a global SortedMap& reference
+ * @param name Name of the SortedMap& reference to define
+ * @param KeyType Integral type to use for key
+ * @param ContentType Object type to declare for content
+ * @note Use DEFINE_FSTR_MAP_SORTED to instantiate the global object
+ */
+#define DECLARE_FSTR_MAP_SORTED(name, KeyType, ContentType)                                                            \
+	DECLARE_FSTR_OBJECT(name, DECL((FSTR::SortedMap<KeyType, ContentType>)))
+
+/**
+ * @brief Define a SortedMap Object with global reference
+ * @param name Name of the SortedMap& reference to define
+ * @param KeyType Integral type to use for key
+ * @param ContentType Object type to declare for content
+ * @param ... List of MapPair definitions { key, &content }, in ascending key order
+ * @note Size will be calculated
+ */
+#define DEFINE_FSTR_MAP_SORTED(name, KeyType, ContentType, ...)                                                        \
+	static DEFINE_FSTR_MAP_DATA_SORTED(FSTR_DATA_NAME(name), KeyType, ContentType, __VA_ARGS__);                       \
+	DEFINE_FSTR_REF_NAMED(name, DECL((FSTR::SortedMap<KeyType, ContentType>)));
+
+/**
+ * @brief Like DEFINE_FSTR_MAP_SORTED except reference is declared static constexpr
+ */
+#define DEFINE_FSTR_MAP_SORTED_LOCAL(name, KeyType, ContentType, ...)                                                  \
+	static DEFINE_FSTR_MAP_DATA_SORTED(FSTR_DATA_NAME(name), KeyType, ContentType, __VA_ARGS__);                       \
+	static constexpr DEFINE_FSTR_REF_NAMED(name, DECL((FSTR::SortedMap<KeyType, ContentType>)));
+
+/**
+ * @brief Define a SortedMap data structure
+ * @param name Name of data structure
+ * @param KeyType Integral type to use for key
+ * @param ContentType Object type to declare for content
+ * @param ... List of MapPair definitions { key, &content }, in ascending key order
+ * @note Integral keys are checked at compile time. String keys cannot be checked,
+ * they must be ordered as for `FSTR::String::compare()` with `ignoreCase = true`.
+ */
+#define DEFINE_FSTR_MAP_DATA_SORTED(name, KeyType, ContentType, ...)                                                   \
+	DEFINE_FSTR_MAP_DATA(name, KeyType, ContentType, __VA_ARGS__)                                                      \
+	static_assert(FSTR::isSorted<KeyType>(name, 0, (sizeof(name.data) / sizeof(name.data[0])) - 1),                   \
+				  "FSTR Map keys not sorted or contain duplicates");
+
+namespace FSTR
+{
+/**
+ * @brief Check map keys are in strictly ascending order, for use in a static_assert
+ * @tparam KeyType
+ * @param map The map data structure
+ * @param first Index of first pair to check
+ * @param last Index of last pair to check
+ * @note Range is split recursively to keep within the compiler's constexpr depth limit
+ */
+template <typename KeyType, class MapData>
+constexpr typename std::enable_if<!std::is_class<KeyType>::value, bool>::type isSorted(const MapData& map, size_t first,
+																						 size_t last)
+{
+	return (first >= last) || (isSorted<KeyType>(map, first, (first + last) / 2) &&
+							   map.data[(first + last) / 2].key_ < map.data[(first + last) / 2 + 1].key_ &&
+							   isSorted<KeyType>(map, (first + last) / 2 + 1, last));
+}
+
+/**
+ * @brief String keys cannot be inspected at compile time
+ */
+template <typename KeyType, class MapData>
+constexpr typename std::enable_if<std::is_class<KeyType>::value, bool>::type isSorted(const MapData&, size_t, size_t)
+{
+	return true;
+}
+
+/**
+ * @brief Class template to access an associative map whose keys are sorted
+ * @tparam KeyType
+ * @tparam ContentType
+ *
+ * Lookups use a binary search so take O(log n) key comparisons instead of O(n).
+ */
+template <typename KeyType, class ContentType> class SortedMap : public Map<KeyType, ContentType>
+{
+public:
+	using Pair = MapPair<KeyType, ContentType>;
+
+	/**
+	 * @brief Lookup an integral key and return the index
+	 * @param key Key to locate, must be compatible with KeyType for comparison
+	 * @retval int If key isn't found, return -1
+	 */
+	template <typename TRefKey, typename T = KeyType>
+	typename std::enable_if<!std::is_class<T>::value, int>::type indexOf(const TRefKey& key) const
+	{
+		Stats::Measure measure(*this, Stats::Event::lookup);
+		auto p = this->data();
+		unsigned first = 0;
+		unsigned last = this->length();
+		while(first < last) {
+			auto mid = first + (last - first) / 2;
+			measure.probe();
+			auto k = p[mid].key();
+			if(k == key) {
+				return mid;
+			}
+			if(k < key) {
+				first = mid + 1;
+			} else {
+				last = mid;
+			}
+		}
+
+		return -1;
+	}
+
+	/**
+	 * @brief Lookup a String key and return the index
+	 * @param key
+	 * @param ignoreCase Whether search is case-sensitive (default: true)
+	 * @retval int If key isn't found, return -1
+	 * @note Keys are ordered without regard to case, so a case-sensitive lookup
+	 * checks all matching keys which differ only in case.
+	 */
+	template <typename TRefKey, typename T = KeyType>
+	typename std::enable_if<std::is_same<T, String>::value, int>::type indexOf(const TRefKey& key,
+																			   bool ignoreCase = true) const
+	{
+		Stats::Measure measure(*this, Stats::Event::lookup);
+		auto p = this->data();
+		unsigned first = 0;
+		unsigned last = this->length();
+		while(first < last) {
+			auto mid = first + (last - first) / 2;
+			measure.probe();
+			int res = p[mid].key().compare(key, true);
+			if(res < 0) {
+				first = mid + 1;
+			} else if(res > 0) {
+				last = mid;
+			} else if(ignoreCase) {
+				return mid;
+			} else {
+				return findExact(mid, key);
+			}
+		}
+
+		return -1;
+	}
+
+	/**
+	 * @brief Lookup a key and return the entry, if found
+	 * @param key
+	 * @note Result validity can be checked using if()
+	 */
+	template <typename TRefKey> const Pair operator[](const TRefKey& key) const
+	{
+		return this->valueAt(indexOf(key));
+	}
+
+private:
+	/*
+	 * Given index of a case-insensitive match, search adjacent entries for an exact match
+	 */
+	template <typename TRefKey> int findExact(unsigned index, const TRefKey& key) const
+	{
+		auto p = this->data();
+		for(int i = index; i >= 0 && p[i].key().compare(key, true) == 0; --i) {
+			if(p[i].key() == key) {
+				return i;
+			}
+		}
+		auto len = this->length();
+		for(unsigned i = index + 1; i < len && p[i].key().compare(key, true) == 0; ++i) {
+			if(p[i].key() == key) {
+				return i;
+			}
+		}
+
+		return -1;
+	}
+};
+
+} // namespace FSTR
+
+/** @} */
@@ -0,0 +1,210 @@
+/****
+ * Stats.hpp - Optional access statistics
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#pragma once
+
+#include "config.hpp"
+
+class Print;
+
+namespace FSTR
+{
+class ObjectBase;
+
+/**
+ * @brief Per-object access statistics
+ *
+ * Build with `FSTR_STATS=1` to record how each object is accessed.
+ * Statistics are kept for up to `FSTR_STATS_MAX_OBJECTS` objects, identified by address.
+ * Copies of an object are counted with the original.
+ *
+ * When disabled, all methods are empty and instrumentation has no overhead.
+ *
+ * @note Recording is not thread-safe
+ */
+namespace Stats
+{
+enum class Event {
+	read,	  ///< ObjectBase::read(), via the CPU cache
+	readFlash, ///< ObjectBase::readFlash(), via flashmem_read()
+	stream,	///< FSTR::Stream::readMemoryBlock()
+	lookup,	///< Map::indexOf() and variants
+	equals,	///< String::equals()
+	MAX,
+};
+
+struct Counter {
+	uint32_t calls;
+	uint32_t bytes;  ///< Bytes read or compared
+	uint32_t cycles; ///< CPU cycles spent
+};
+
+struct Entry {
+	const void* data; ///< Object data, identifies the object
+	uint32_t length;  ///< Object length in bytes
+	Counter counters[unsigned(Event::MAX)];
+	uint32_t probes; ///< Number of keys examined by lookups
+
+	const Counter& operator[](Event event) const
+	{
+		return counters[unsigned(event)];
+	}
+
+	/**
+	 * @brief Get total for all events
+	 */
+	Counter total() const
+	{
+		Counter res{};
+		for(auto& c : counters) {
+			res.calls += c.calls;
+			res.bytes += c.bytes;
+			res.cycles += c.cycles;
+		}
+		return res;
+	}
+};
+
+#if FSTR_STATS
+
+/**
+ * @brief Get the number of CPU cycles elapsed
+ */
+uint32_t clock();
+
+/**
+ * @brief Record an access
+ * @param object
+ * @param event
+ * @param bytes Number of bytes read or compared
+ * @param cycles Time taken
+ * @param probes For lookups, number of keys examined
+ */
+void record(const ObjectBase& object, Event event, size_t bytes, uint32_t cycles, unsigned probes = 0);
+
+/**
+ * @brief Get statistics for an object
+ * @retval const Entry* nullptr if object has not been accessed
+ */
+const Entry* find(const ObjectBase& object);
+
+/**
+ * @brief Get number of objects for which statistics have been recorded
+ */
+unsigned count();
+
+/**
+ * @brief Get number of accesses not recorded because the table is full
+ */
+unsigned dropped();
+
+/**
+ * @brief Discard all statistics recorded so far
+ */
+void reset();
+
+/**
+ * @brief Print a report of the most heavily used objects
+ * @param p
+ * @param maxEntries Number of objects to list
+ * @retval size_t Number of characters written
+ * @note Objects are sorted by the total time spent accessing them
+ */
+size_t printReport(Print& p, unsigned maxEntries = 10);
+
+/**
+ * @brief Records accesses for the lifetime of this object
+ */
+class Measure
+{
+public:
+	Measure(const ObjectBase& object, Event event) : object(object), event(event), start(clock())
+	{
+	}
+
+	~Measure()
+	{
+		record(object, event, bytes, clock() - start, probes);
+	}
+
+	void setBytes(size_t count)
+	{
+		bytes = count;
+	}
+
+	void probe()
+	{
+		++probes;
+	}
+
+private:
+	const ObjectBase& object;
+	Event event;
+	uint32_t start;
+	size_t bytes = 0;
+	unsigned probes = 0;
+};
+
+#else
+
+inline const Entry* find(const ObjectBase&)
+{
+	return nullptr;
+}
+
+inline unsigned count()
+{
+	return 0;
+}
+
+inline unsigned dropped()
+{
+	return 0;
+}
+
+inline void reset()
+{
+}
+
+inline size_t printReport(Print&, unsigned = 10)
+{
+	return 0;
+}
+
+class Measure
+{
+public:
+	Measure(const ObjectBase&, Event)
+	{
+	}
+
+	void setBytes(size_t)
+	{
+	}
+
+	void probe()
+	{
+	}
+};
+
+#endif
+
+} // namespace Stats
+
+} // namespace FSTR
@@ -39,7 +39,17 @@ public:
 	 * @param object
 	 * @param flashread Specify true to read using flashmem functions, otherwise data is accessed via cache
 	 */
-	Stream(const ObjectBase& object, bool flashread = true) : object(object), flashread(flashread)
+	Stream(const ObjectBase& object, bool flashread = true) : slice(object.slice(0)), flashread(flashread)
+	{
+	}
+
+	/**
+	 * @brief Construct a stream for part of an object
+	 * @param slice Range of object to read, for example to serve an HTTP Range request
+	 * @param flashread
+	 * @note Stream positions are relative to the start of the slice
+	 */
+	Stream(const Slice& slice, bool flashread = true) : slice(slice), flashread(flashread)
 	{
 	}
 
@@ -54,20 +64,51 @@ public:
 	*/
 	int available() override
 	{
-		return object.length() - readPos;
+		return slice.length() - readPos;
 	}
 
 	uint16_t readMemoryBlock(char* data, int bufSize) override;
 
+	/**
+	 * @brief Read data from a given position
+	 * @param offset Position in stream
+	 * @param buffer Where to store data
+	 * @param count Number of bytes to read
+	 * @retval size_t Number of bytes actually read
+	 * @note The read position is neither used nor changed, so this may be called
+	 * concurrently from several tasks.
+	 */
+	size_t pread(size_t offset, void* buffer, size_t count) const
+	{
+		return flashread ? slice.readFlash(offset, buffer, count) : slice.read(offset, buffer, count);
+	}
+
+	/**
+	 * @brief Get a pointer to the data at the current read position, without copying
+	 * @retval const char* nullptr if stream was created with `flashread = true`
+	 * @note `available()` gives the number of bytes which may be accessed.
+	 * Call `seek()` to advance the read position once the data has been consumed.
+	 *
+	 * The data is in memory-mapped flash, so on the ESP8266 it must be accessed
+	 * using aligned 32-bit reads, for example via `memcpy_P()`.
+	 */
+	const char* getStreamPointer() const
+	{
+		if(flashread) {
+			return nullptr;
+		}
+		return reinterpret_cast<const char*>(slice.data()) + readPos;
+	}
+
 	int seekFrom(int offset, SeekOrigin origin) override;
 
 	bool isFinished() override
 	{
-		return readPos >= object.length();
+		return readPos >= slice.length();
 	}
 
 private:
-	const ObjectBase& object;
+	Slice slice;
 	size_t readPos = 0;
 	bool flashread;
 };
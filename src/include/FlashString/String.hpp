@@ -94,9 +94,66 @@ typedef const __FlashStringHelper* flash_string_t;
 	constexpr const struct {                                                                                           \
 		FSTR::ObjectBase object;                                                                                       \
 		char data[ALIGNUP4(sizeof(str))];                                                                              \
-	} name PROGMEM = {{sizeof(str) - 1}, str};                                                                         \
+	} name PROGMEM = {{FSTR::ObjectBase::typedLength(sizeof(str) - 1, FSTR::Type::string, 1)}, str};                   \
 	FSTR_CHECK_STRUCT(name);
 
+/**
+ * @brief Define a FSTR::String object with global reference and a pre-computed hash
+ * @param name Name of FSTR::String& reference to define
+ * @param str Content of the FSTR::String
+ *
+ * The hash is calculated at compile time and stored immediately before the object.
+ * It is used to reject most non-matching Strings in equality tests and lookups
+ * without reading their content.
+ */
+#define DEFINE_FSTR_HASHED(name, str)                                                                                  \
+	static DEFINE_FSTR_DATA_HASHED(FSTR_DATA_NAME(name), str);                                                         \
+	DEFINE_FSTR_REF_NAMED(name, FSTR::String);
+
+/**
+ * @brief Like DEFINE_FSTR_HASHED except reference is declared static constexpr
+ */
+#define DEFINE_FSTR_HASHED_LOCAL(name, str)                                                                            \
+	static DEFINE_FSTR_DATA_HASHED(FSTR_DATA_NAME(name), str);                                                         \
+	static constexpr DEFINE_FSTR_REF_NAMED(name, FSTR::String);
+
+/**
+ * @brief Define a FSTR::String which is stored only once, however many times it is defined
+ * @param name Name of FSTR::String& reference to define, also identifies the pooled data
+ * @param str Content of the FSTR::String, a single string literal
+ *
+ * Place definitions in a header which is included wherever they are required.
+ * The reference is static constexpr, so may be used in Map and Vector definitions in any
+ * translation unit. These all refer to the same object, so for example `String::equals()`
+ * succeeds without comparing content.
+ *
+ * The pool is identified by name only, so all definitions for a given name must have the same content.
+ *
+ * @see See `FSTR_POOL_DATA`
+ */
+#define DEFINE_FSTR_POOLED(name, str)                                                                                  \
+	FSTR_POOL_DATA(FSTR_DATA_NAME(name), str)                                                                          \
+	extern "C" __attribute__((visibility("hidden"))) const FSTR::ObjectBase FSTR_DATA_NAME(name);                      \
+	static constexpr DEFINE_FSTR_REF(name, FSTR::String, FSTR_DATA_NAME(name));
+
+/**
+ * @brief Define a FSTR::String data structure with a pre-computed hash
+ * @param name Name of data structure
+ * @param str Quoted string content
+ */
+#define DEFINE_FSTR_DATA_HASHED(name, str)                                                                             \
+	constexpr const struct {                                                                                           \
+		uint32_t hash;                                                                                                 \
+		FSTR::ObjectBase object;                                                                                       \
+		char data[ALIGNUP4(sizeof(str))];                                                                              \
+	} name PROGMEM = {                                                                                                 \
+		FSTR::Hash::literal(str, sizeof(str) - 1),                                                                     \
+		{FSTR::ObjectBase::typedLength(sizeof(str) - 1, FSTR::Type::string, 1) | FSTR::ObjectBase::hashBit},           \
+		str};                                                                                                          \
+	static_assert(std::is_pod<decltype(name)>::value, "FSTR structure not POD");                                       \
+	static_assert(offsetof(decltype(name), data) == offsetof(decltype(name), object) + sizeof(uint32_t),               \
+				  "FSTR structure alignment error");
+
 /**
  * @brief Load a FSTR::String object into a named local (stack) buffer
  *
@@ -137,6 +194,20 @@ typedef const __FlashStringHelper* flash_string_t;
  */
 #define IMPORT_FSTR_LOCAL(name, file) IMPORT_FSTR_OBJECT_LOCAL(name, FSTR::String, file)
 
+/**
+ * @brief Define a FSTR::String containing data from an external file, with a stored digest
+ * @param name Name for the FSTR::String object
+ * @param file Absolute path to the file containing the content
+ * @param digest Digest value, generated using `tools/fstr-digest.py`
+ * @see See also `ObjectBase::digest()`
+ */
+#define IMPORT_FSTR_DIGEST(name, file, digest) IMPORT_FSTR_OBJECT_DIGEST(name, FSTR::String, file, digest)
+
+/**
+ * @brief Like IMPORT_FSTR_DIGEST except reference is declared static constexpr
+ */
+#define IMPORT_FSTR_DIGEST_LOCAL(name, file, digest) IMPORT_FSTR_OBJECT_DIGEST_LOCAL(name, FSTR::String, file, digest)
+
 /**
  * @brief declare a table of FlashStrings
  * @param name name of the table
@@ -195,7 +266,7 @@ public:
 	 * @param cstr
 	 * @param len Length of cstr (optional)
 	 * @retval bool true if strings are identical
-	 * @note loads string into a stack buffer for the comparison, no heap required
+	 * @note Content is compared in small chunks, no heap required
 	 */
 	bool equals(const char* cstr, size_t len = 0) const;
 
@@ -205,6 +276,45 @@ public:
 	 */
 	bool equals(const String& str) const;
 
+	/**
+	 * @brief Check for equality with a C-string, ignoring case
+	 * @param cstr
+	 * @param len Length of cstr (optional)
+	 * @retval bool true if strings are identical, ignoring case
+	 */
+	bool equalsIgnoreCase(const char* cstr, size_t len = 0) const;
+
+	/**
+	 * @brief Check for equality with another String, ignoring case
+	 * @param str
+	 * @retval bool true if strings are identical, ignoring case
+	 */
+	bool equalsIgnoreCase(const String& str) const;
+
+	/**
+	 * @brief Compare with a C-string
+	 * @param cstr
+	 * @param len Length of cstr
+	 * @param ignoreCase Whether comparison is case-insensitive
+	 * @retval int <0 if this String sorts before cstr, >0 if after, 0 if equal
+	 * @note Ordering is as for `memcmp()`, with shorter strings sorting first.
+	 * Case-insensitive comparisons order as if both strings were converted to lower case.
+	 */
+	int compare(const char* cstr, size_t len, bool ignoreCase) const;
+
+	int compare(const char* cstr, bool ignoreCase = false) const
+	{
+		return compare(cstr, (cstr == nullptr) ? 0 : strlen(cstr), ignoreCase);
+	}
+
+	/**
+	 * @brief Compare with another String
+	 * @param str
+	 * @param ignoreCase Whether comparison is case-insensitive
+	 * @retval int <0 if this String sorts before str, >0 if after, 0 if equal
+	 */
+	int compare(const String& str, bool ignoreCase = false) const;
+
 	bool operator==(const char* str) const
 	{
 		return equals(str);
@@ -225,6 +335,85 @@ public:
 		return !equals(str);
 	}
 
+	/* Searching */
+
+	/**
+	 * @brief Find a character
+	 * @param c
+	 * @param fromIndex Where to start searching
+	 * @retval int Index of first occurrence, or -1 if not found
+	 * @note Content is scanned a word at a time, see `findFlash()`
+	 */
+	int indexOf(char c, size_t fromIndex = 0) const
+	{
+		return findFlash(data(), length(), c, fromIndex);
+	}
+
+	/**
+	 * @brief Find a substring
+	 * @param str
+	 * @param fromIndex Where to start searching
+	 * @retval int Index of first occurrence, or -1 if not found
+	 */
+	int indexOf(const char* str, size_t fromIndex = 0) const
+	{
+		return (str == nullptr) ? -1 : searchFlash(data(), length(), str, strlen(str), fromIndex);
+	}
+
+	int indexOf(const WString& str, size_t fromIndex = 0) const;
+
+	bool contains(char c) const
+	{
+		return indexOf(c) >= 0;
+	}
+
+	bool contains(const char* str) const
+	{
+		return indexOf(str) >= 0;
+	}
+
+	bool contains(const WString& str) const
+	{
+		return indexOf(str) >= 0;
+	}
+
+	/**
+	 * @brief Check whether String starts with the given text
+	 * @param prefix
+	 * @param len Length of prefix (optional)
+	 */
+	bool startsWith(const char* prefix, size_t len = 0) const;
+
+	bool startsWith(const WString& prefix) const;
+
+	/**
+	 * @brief Check whether String ends with the given text
+	 * @param suffix
+	 * @param len Length of suffix (optional)
+	 */
+	bool endsWith(const char* suffix, size_t len = 0) const;
+
+	bool endsWith(const WString& suffix) const;
+
+	/**
+	 * @brief Get hash value for this String
+	 * @retval uint32_t Value as for `Hash::calculate()`, case-insensitive
+	 * @note If the hash wasn't stored when the String was defined then it is computed,
+	 * which requires reading the entire content.
+	 */
+	uint32_t hash() const;
+
+	/**
+	 * @brief Quick check for a possible match against a value with the given hash
+	 * @param hash Hash of comparison value
+	 * @retval bool false if String definitely doesn't match, even ignoring case
+	 * @note Only stored hash values are used, no content is read
+	 */
+	bool matchesHash(uint32_t hash) const
+	{
+		return !hasHash() || storedHash() == hash;
+	}
+
 	/* WString support */
 
 	operator WString() const;
@@ -233,6 +422,8 @@ public:
 
 	bool equalsIgnoreCase(const WString& str) const;
 
+	int compare(const WString& str, bool ignoreCase = false) const;
+
 	bool operator==(const WString& str) const
 	{
 		return equals(str);
@@ -256,7 +447,17 @@ public:
 	 */
 	StringPrinter printer() const
 	{
-		return StringPrinter(*this);
+		return StringPrinter(slice(0));
+	}
+
+	/**
+	 * @brief Supports printing of large String objects using a caller-supplied buffer
+	 * @param buffer
+	 * @param bufferSize Writes are made in blocks of this size
+	 */
+	StringPrinter printer(char* buffer, size_t bufferSize) const
+	{
+		return StringPrinter(slice(0), buffer, bufferSize);
 	}
 
 	size_t printTo(Print& p) const
@@ -265,6 +466,67 @@ public:
 	}
 };
 
+namespace Hash
+{
+/**
+ * @brief Hash functions for String comparison values
+ * @{
+ */
+FSTR_INLINE uint32_t calculate(const char* cstr)
+{
+	return calculate(cstr, (cstr == nullptr) ? 0 : strlen(cstr));
+}
+
+uint32_t calculate(const WString& str);
+
+FSTR_INLINE uint32_t calculate(const String& str)
+{
+	return str.hash();
+}
+
+/** @} */
+
+/**
+ * @brief Hash of a lookup key, only calculated if a String with a stored hash is compared against it
+ *
+ * Most Strings have no stored hash, so a search through them would gain nothing from hashing the key.
+ *
+ * 		Hash::LazyKey<TRefKey> keyHash(key);
+ * 		for(...) {
+ * 			if(keyHash.mayMatch(str) && str.equals(key)) {
+ * 				...
+ */
+template <typename T> class LazyKey
+{
+public:
+	explicit LazyKey(const T& key) : key(key)
+	{
+	}
+
+	/**
+	 * @brief Quick check for a possible match
+	 * @retval bool false if str definitely doesn't match the key, even ignoring case
+	 */
+	bool mayMatch(const String& str)
+	{
+		if(!str.hasHash()) {
+			return true;
+		}
+		if(!hashed) {
+			value = calculate(key);
+			hashed = true;
+		}
+		return str.storedHash() == value;
+	}
+
+private:
+	const T& key;
+	uint32_t value = 0;
+	bool hashed = false;
+};
+
+} // namespace Hash
+
 } // namespace FSTR
 
 /** @} */
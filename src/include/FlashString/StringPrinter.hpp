@@ -19,29 +19,58 @@
 
 #pragma once
 
+#include "Slice.hpp"
 #include <Printable.h>
 
 namespace FSTR
 {
-class String;
-
 /**
- * @brief Wrapper class to efficiently print large Strings
+ * @brief Wrapper class to efficiently print large Strings, or slices of them
  *
  * Outputs in chunks to avoid loading the entire content into RAM.
  * Used by String::printTo() method.
+ *
+ * By default, a stack buffer of FSTR_PRINT_CHUNK_SIZE bytes is used.
+ * A larger buffer may be provided to reduce the number of writes, for example
+ * to match the TCP segment size.
  */
 class StringPrinter : public Printable
 {
 public:
-	StringPrinter(const String& string) : string(string)
+	StringPrinter(const Slice& slice) : slice(slice)
+	{
+	}
+
+	/**
+	 * @brief Print using a caller-supplied buffer
+	 * @param slice
+	 * @param buffer Must remain valid until printing has completed
+	 * @param bufferSize Size of buffer, determines size of each write
+	 */
+	StringPrinter(const Slice& slice, char* buffer, size_t bufferSize)
+		: slice(slice), buffer(buffer), bufferSize(bufferSize)
 	{
 	}
 
+	/**
+	 * @brief Set threshold for reading via the CPU cache
+	 * @param threshold Strings up to this length are read via the cache, longer ones using `flashmem_read()`
+	 * @note Default is FSTR_PRINT_CACHE_THRESHOLD
+	 */
+	void setCacheThreshold(size_t threshold)
+	{
+		cacheThreshold = threshold;
+	}
+
 	size_t printTo(Print& p) const override;
 
 private:
-	const String& string;
+	size_t printChunks(Print& p, char* buf, size_t bufSize) const;
+
+	Slice slice;
+	char* buffer = nullptr;
+	size_t bufferSize = 0;
+	size_t cacheThreshold = FSTR_PRINT_CACHE_THRESHOLD;
 };
 
 } // namespace FSTR
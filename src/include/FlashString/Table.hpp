@@ -21,6 +21,7 @@
 
 #pragma once
 
+#include "Object.hpp"
 #include "ArrayPrinter.hpp"
 
 /**
@@ -29,6 +30,55 @@
  * @{
  */
 
+/**
+ * @brief Declare a global Table& reference
+ * @param name
+ * @param ElementType
+ * @param Columns
+ * @note Use `DEFINE_FSTR_TABLE` to instantiate the global Object
+ */
+#define DECLARE_FSTR_TABLE(name, ElementType, Columns)                                                                 \
+	DECLARE_FSTR_OBJECT(name, DECL((FSTR::Table<ElementType, Columns>)))
+
+/**
+ * @brief Define a Table Object with global reference
+ * @param name Name of Table& reference to define
+ * @param ElementType
+ * @param Columns Number of columns
+ * @param ... List of ElementType items, given column by column
+ *
+ * All values for the first column come first, then all values for the second column, and so on.
+ * The number of rows is determined by the number of values.
+ */
+#define DEFINE_FSTR_TABLE(name, ElementType, Columns, ...)                                                             \
+	static DEFINE_FSTR_TABLE_DATA(FSTR_DATA_NAME(name), ElementType, Columns, __VA_ARGS__);                            \
+	DEFINE_FSTR_REF_NAMED(name, DECL((FSTR::Table<ElementType, Columns>)));
+
+/**
+ * @brief Like DEFINE_FSTR_TABLE except reference is declared static constexpr
+ */
+#define DEFINE_FSTR_TABLE_LOCAL(name, ElementType, Columns, ...)                                                       \
+	static DEFINE_FSTR_TABLE_DATA(FSTR_DATA_NAME(name), ElementType, Columns, __VA_ARGS__);                            \
+	static constexpr DEFINE_FSTR_REF_NAMED(name, DECL((FSTR::Table<ElementType, Columns>)));
+
+/**
+ * @brief Define a Table data structure
+ * @param name Name of data structure
+ * @param ElementType
+ * @param Columns Number of columns
+ * @param ... List of ElementType items, given column by column
+ * @note Storage is identical to an Array, so type information (if enabled) describes the elements
+ */
+#define DEFINE_FSTR_TABLE_DATA(name, ElementType, Columns, ...)                                                        \
+	constexpr const struct {                                                                                           \
+		FSTR::ObjectBase object;                                                                                       \
+		ElementType data[sizeof((const ElementType[]){__VA_ARGS__}) / sizeof(ElementType)];                            \
+	} FSTR_PACKED FSTR_ALIGNED name PROGMEM = {                                                                        \
+		{FSTR::ObjectBase::typedLength(sizeof(name.data), FSTR::arrayType<ElementType>(), sizeof(ElementType))},       \
+		{__VA_ARGS__}};                                                                                                \
+	static_assert(sizeof(name.data) % (sizeof(ElementType) * (Columns)) == 0, "Table columns have unequal length");    \
+	FSTR_CHECK_STRUCT(name);
+
 namespace FSTR
 {
 /**
@@ -82,6 +132,159 @@ public:
 	ElementType values[Columns];
 };
 
+/**
+ * @brief Class template to access a table of values stored by column
+ * @tparam ElementType
+ * @tparam Columns Number of columns in the table
+ *
+ * Values are stored column by column (struct-of-arrays) so each column is contiguous in flash.
+ * Compared with an `Array<TableRow>`:
+ *
+ * - a single cell is read without copying the entire row
+ * - a column can be scanned or read in bulk without loading other columns
+ * - whole rows are assembled on request, see `row()` and `readRows()`
+ *
+ * Inherited Object methods such as `length()`, `valueAt()`, `read()` and iteration operate on
+ * the underlying elements in storage order.
+ */
+template <typename ElementType, size_t Columns> class Table : public Object<Table<ElementType, Columns>, ElementType>
+{
+public:
+	using Row = TableRow<ElementType, Columns>;
+
+	/**
+	 * @brief Get number of rows
+	 */
+	size_t rows() const
+	{
+		return this->length() / Columns;
+	}
+
+	/**
+	 * @brief Get number of columns
+	 */
+	size_t columns() const
+	{
+		return Columns;
+	}
+
+	/**
+	 * @brief Read a single cell
+	 * @param row
+	 * @param col
+	 * @retval ElementType Value, or default if either index is out of range
+	 */
+	ElementType cell(unsigned row, unsigned col) const
+	{
+		auto numRows = rows();
+		if(row < numRows && col < Columns) {
+			return readValue(this->data() + col * numRows + row);
+		} else {
+			return ElementType{};
+		}
+	}
+
+	/**
+	 * @brief Cell access operator, `table(row, col)`
+	 */
+	FSTR_INLINE ElementType operator()(unsigned row, unsigned col) const
+	{
+		return cell(row, col);
+	}
+
+	/**
+	 * @brief Get pointer to start of column data in flash
+	 * @param col
+	 * @retval const ElementType* nullptr if col is out of range
+	 * @note Contains `rows()` elements. Use `readValue()` or `memcpy_P()` to access.
+	 */
+	const ElementType* column(unsigned col) const
+	{
+		return (col < Columns) ? this->data() + col * rows() : nullptr;
+	}
+
+	/**
+	 * @brief Read values from one column into RAM
+	 * @param col Column to read
+	 * @param row First row to read
+	 * @param buffer Where to store values
+	 * @param count Number of values to read
+	 * @retval size_t Number of values actually read
+	 */
+	size_t readColumn(unsigned col, size_t row, ElementType* buffer, size_t count) const
+	{
+		auto numRows = rows();
+		if(col >= Columns || row >= numRows) {
+			return 0;
+		}
+
+		count = std::min(count, numRows - row);
+		return this->read(col * numRows + row, buffer, count);
+	}
+
+	/**
+	 * @brief Get an entire row
+	 * @param row
+	 * @retval Row Empty row if out of range
+	 */
+	Row row(unsigned row) const
+	{
+		Row r = Row::empty();
+		readRows(row, &r, 1);
+		return r;
+	}
+
+	/**
+	 * @brief Read a range of rows into RAM
+	 * @param row First row to read
+	 * @param buffer Where to store rows
+	 * @param count Number of rows to read
+	 * @retval size_t Number of rows actually read
+	 *
+	 * Each column is read in blocks via a small stack buffer, so flash is accessed sequentially
+	 * rather than one cell at a time.
+	 */
+	size_t readRows(size_t row, Row* buffer, size_t count) const
+	{
+		auto numRows = rows();
+		if(row >= numRows) {
+			return 0;
+		}
+
+		count = std::min(count, numRows - row);
+		constexpr size_t blockElements = (blockSize > sizeof(ElementType)) ? blockSize / sizeof(ElementType) : 1;
+		ElementType block[blockElements] FSTR_ALIGNED;
+		for(unsigned col = 0; col < Columns; ++col) {
+			auto start = col * numRows + row;
+			for(size_t i = 0; i < count; i += blockElements) {
+				auto n = this->read(start + i, block, std::min(count - i, blockElements));
+				for(unsigned j = 0; j < n; ++j) {
+					buffer[i + j].values[col] = block[j];
+				}
+			}
+		}
+
+		return count;
+	}
+
+	/**
+	 * @brief Print table, one row per line
+	 */
+	size_t printTo(Print& p) const
+	{
+		size_t count = 0;
+		auto numRows = rows();
+		for(unsigned i = 0; i < numRows; ++i) {
+			count += row(i).printTo(p);
+			count += p.println();
+		}
+		return count;
+	}
+
+private:
+	static constexpr size_t blockSize = 64;
+};
+
 } // namespace FSTR
 
 /** @} */
@@ -0,0 +1,86 @@
+/****
+ * TypeInfo.hpp - Run-time type information for objects
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#pragma once
+
+#include "config.hpp"
+#include <type_traits>
+
+namespace FSTR
+{
+/**
+ * @brief Identifies the type of an object, stored in the object header
+ * @ingroup fstr_object
+ * @see See `FSTR_TYPE_INFO`
+ */
+enum class Type : uint8_t {
+	none,		   ///< No type information, e.g. imported or custom objects, or FSTR_TYPE_INFO disabled
+	character,	 ///< Array<char>
+	signedInt,	 ///< Array of signed integers
+	unsignedInt,   ///< Array of unsigned integers, enums or bool
+	floatingPoint, ///< Array<float> or Array<double>
+	structure,	 ///< Array of structures, such as a Table
+	string,		   ///< String
+	vector,		   ///< Vector, elements are object pointers
+	stringMap,	 ///< Map with String keys
+	signedMap,	 ///< Map with signed integer keys
+	unsignedMap,   ///< Map with unsigned integer or enum keys
+	floatMap,	  ///< Map with floating-point keys
+	userDefined = 16,
+	maxValue = 31,
+};
+
+/**
+ * @brief Get the type of an Array containing a given element type
+ */
+template <typename ElementType> constexpr Type arrayType()
+{
+	return std::is_same<ElementType, char>::value
+			   ? Type::character
+			   : std::is_floating_point<ElementType>::value
+					 ? Type::floatingPoint
+					 : std::is_signed<ElementType>::value
+						   ? Type::signedInt
+						   : (std::is_integral<ElementType>::value || std::is_enum<ElementType>::value)
+								 ? Type::unsignedInt
+								 : Type::structure;
+}
+
+/**
+ * @brief Get the type of a Map using a given key type
+ */
+template <typename KeyType> constexpr Type mapType()
+{
+	return std::is_class<KeyType>::value
+			   ? Type::stringMap
+			   : std::is_floating_point<KeyType>::value
+					 ? Type::floatMap
+					 : std::is_signed<KeyType>::value ? Type::signedMap : Type::unsignedMap;
+}
+
+/**
+ * @brief Get the size of a key as stored in a Map
+ * @note String keys are stored as pointers
+ */
+template <typename KeyType> constexpr size_t mapKeySize()
+{
+	return std::is_class<KeyType>::value ? sizeof(void*) : sizeof(KeyType);
+}
+
+} // namespace FSTR
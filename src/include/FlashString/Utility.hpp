@@ -97,12 +97,93 @@ template <typename T, typename U> struct argument_type<T(U)> {
 			"_" STR(name) "_end:\n");
 #else
 #define IMPORT_FSTR_DATA(name, file)                                                                                   \
-	__asm__(".section " ICACHE_RODATA_SECTION "." #name "\n"                                                           \
+	__asm__(".pushsection " ICACHE_RODATA_SECTION "." #name "\n"                                                       \
 			".type " STR(name) ", @object\n"                                                                           \
 			".align 4\n" STR(name) ":\n"                                                                               \
 			".long _" STR(name) "_end - " STR(name) " - 4\n"                                                           \
 			".incbin \"" file "\"\n"                                                                                   \
+			"_" STR(name) "_end:\n"                                                                                    \
+			".popsection\n");
+#endif
+
+/**
+ * @def IMPORT_FSTR_DATA_DIGEST
+ * @brief Link the contents of a file, with a digest of the content stored in the object header
+ * @param name Name of the symbol
+ * @param file Path to the file
+ * @param digest Literal value of digest, generated using `tools/fstr-digest.py`
+ *
+ * The assembler cannot calculate the digest itself. It must be supplied, and re-generated
+ * whenever the file changes. Use `ObjectBase::digest()` to obtain the value.
+ */
+// Must match FSTR::ObjectBase::digestBit
+#define FSTR_DIGEST_LENGTH_FLAGS 0x10000000
+#ifdef __WIN32
+#define IMPORT_FSTR_DATA_DIGEST(name, file, digest)                                                                    \
+	__asm__(".section .rodata\n"                                                                                       \
+			".align 4\n"                                                                                               \
+			".long " STR(digest) "\n"                                                                                  \
+			".def _" STR(name) "; .scl 2; .type 32; .endef\n"                                                          \
+			"_" STR(name) ":\n"                                                                                        \
+			".long " STR(FSTR_DIGEST_LENGTH_FLAGS) " + _" STR(name) "_end - _" STR(name) " - 4\n"                      \
+			".incbin \"" file "\"\n"                                                                                   \
 			"_" STR(name) "_end:\n");
+#else
+#define IMPORT_FSTR_DATA_DIGEST(name, file, digest)                                                                    \
+	__asm__(".pushsection " ICACHE_RODATA_SECTION "." #name "\n"                                                       \
+			".align 4\n"                                                                                               \
+			".long " STR(digest) "\n"                                                                                  \
+			".type " STR(name) ", @object\n" STR(name) ":\n"                                                           \
+			".long " STR(FSTR_DIGEST_LENGTH_FLAGS) " + _" STR(name) "_end - " STR(name) " - 4\n"                       \
+			".incbin \"" file "\"\n"                                                                                   \
+			"_" STR(name) "_end:\n"                                                                                    \
+			".popsection\n");
+#endif
+
+/**
+ * @def FSTR_POOL_DATA
+ * @brief Define String data which is shared between all translation units
+ * @param name Name of the symbol
+ * @param str String literal
+ *
+ * Data is placed in a COMDAT section named after the symbol, so where the same definition
+ * appears in several translation units (e.g. via a header) the linker keeps only one copy.
+ *
+ * No C/C++ symbol is declared. Use `DEFINE_FSTR_POOLED` instead.
+ */
+#if FSTR_TYPE_INFO
+// Must match FSTR::ObjectBase::typedLength(0, Type::string, 1)
+#define FSTR_POOL_LENGTH_FLAGS 0x23000000
+#else
+#define FSTR_POOL_LENGTH_FLAGS 0
+#endif
+#ifdef __WIN32
+#define FSTR_POOL_DATA(name, str)                                                                                      \
+	__asm__(".section .rdata$" STR(name) ",\"dr\"\n"                                                                   \
+			".linkonce discard\n"                                                                                      \
+			".globl _" STR(name) "\n"                                                                                  \
+			".def _" STR(name) "; .scl 2; .type 32; .endef\n"                                                          \
+			".align 4\n"                                                                                               \
+			"_" STR(name) ":\n"                                                                                        \
+			".long " STR(FSTR_POOL_LENGTH_FLAGS) " + _" STR(name) "_end - _" STR(name) " - 4\n"                        \
+			".ascii " STR(str) "\n"                                                                                    \
+			"_" STR(name) "_end:\n"                                                                                    \
+			".byte 0\n"                                                                                                \
+			".balign 4\n"                                                                                              \
+			".text\n");
+#else
+#define FSTR_POOL_DATA(name, str)                                                                                      \
+	__asm__(".pushsection " ICACHE_RODATA_SECTION "." STR(name) ",\"aG\",@progbits," STR(name) ",comdat\n"             \
+			".globl " STR(name) "\n"                                                                                   \
+			".hidden " STR(name) "\n"                                                                                  \
+			".type " STR(name) ", @object\n"                                                                           \
+			".align 4\n" STR(name) ":\n"                                                                               \
+			".long " STR(FSTR_POOL_LENGTH_FLAGS) " + _" STR(name) "_end - " STR(name) " - 4\n"                         \
+			".ascii " STR(str) "\n"                                                                                    \
+			"_" STR(name) "_end:\n"                                                                                    \
+			".byte 0\n"                                                                                                \
+			".balign 4\n"                                                                                              \
+			".popsection\n");
 #endif
 // clang-format on
 
@@ -125,11 +206,24 @@ template <typename T> FSTR_INLINE typename std::enable_if<sizeof(T) == 2, T>::ty
 	return static_cast<T>(pgm_read_word(ptr));
 }
 
-template <typename T> FSTR_INLINE typename std::enable_if<sizeof(T) == 4, T>::type readValue(const T* ptr)
+template <typename T>
+FSTR_INLINE typename std::enable_if<sizeof(T) == 4 && std::is_integral<T>::value, T>::type readValue(const T* ptr)
 {
 	return T(pgm_read_dword(ptr));
 }
 
+/*
+ * Floats, pointers, etc. must be copied, not converted
+ */
+template <typename T>
+FSTR_INLINE typename std::enable_if<sizeof(T) == 4 && !std::is_integral<T>::value, T>::type readValue(const T* ptr)
+{
+	uint32_t word = pgm_read_dword(ptr);
+	T value;
+	memcpy(&value, &word, sizeof(T));
+	return value;
+}
+
 template <typename T>
 FSTR_INLINE typename std::enable_if<(sizeof(T) > 4) && IS_ALIGNED(sizeof(T)), T>::type readValue(const T* ptr)
 {
@@ -140,6 +234,150 @@ FSTR_INLINE typename std::enable_if<(sizeof(T) > 4) && IS_ALIGNED(sizeof(T)), T>
 
 /** @} */
 
+/**
+ * @brief Number of bytes read from flash at a time by `compareFlash()`
+ */
+constexpr size_t compareChunkSize = 32;
+
+/**
+ * @brief Compare flash data with data in RAM
+ * @param flashData Pointer to data in flash memory
+ * @param data Data in RAM
+ * @param length Number of bytes to compare
+ * @param ignoreCase true to compare without regard to case
+ * @retval int As for `memcmp()`
+ *
+ * Flash data is read in small chunks, stopping at the first chunk containing a difference.
+ * Stack usage is fixed, regardless of the length of data.
+ * flashData need not be aligned, but aligned reads are faster.
+ */
+int compareFlash(const void* flashData, const void* data, size_t length, bool ignoreCase = false);
+
+/**
+ * @brief Search flash data for a byte value
+ * @param flashData Word-aligned pointer to data in flash memory
+ * @param length Number of bytes of data
+ * @param c Value to find
+ * @param offset Where to start searching
+ * @retval int Offset of first match, or -1 if not found
+ *
+ * Data is read one aligned word at a time and all four bytes are tested together (SWAR),
+ * so no single-byte flash accesses are made.
+ */
+int findFlash(const void* flashData, size_t length, uint8_t c, size_t offset = 0);
+
+/**
+ * @brief Search flash data for a 16-bit value
+ * @param flashData Word-aligned pointer to data in flash memory
+ * @param count Number of 16-bit elements
+ * @param value Value to find
+ * @param index Element to start searching from
+ * @retval int Index of first match, or -1 if not found
+ */
+int findFlash16(const void* flashData, size_t count, uint16_t value, size_t index = 0);
+
+/**
+ * @brief Search flash data for a sequence of bytes
+ * @param flashData Word-aligned pointer to data in flash memory
+ * @param length Number of bytes of flash data
+ * @param data Sequence to find, in RAM
+ * @param dataLength Number of bytes in sequence
+ * @param offset Where to start searching
+ * @retval int Offset of first match, or -1 if not found
+ * @note Candidate positions are located using `findFlash()` on the first byte
+ */
+int searchFlash(const void* flashData, size_t length, const void* data, size_t dataLength, size_t offset = 0);
+
+/**
+ * @brief Hash functions used for fast lookups
+ *
+ * A 32-bit FNV-1a hash is used, with ASCII letters folded to lower case so that
+ * Strings which compare equal ignoring case produce the same value.
+ * The same calculation must be used by any host tools which generate hashed structures.
+ */
+namespace Hash
+{
+constexpr uint32_t offsetBasis = 2166136261U;
+constexpr uint32_t prime = 16777619U;
+
+/**
+ * @brief Add data to a content digest
+ * @param digest Initial value, start with `offsetBasis`
+ * @param data Data to add, must be in RAM
+ * @param length Number of bytes
+ * @retval uint32_t Updated digest
+ * @note Like `update()` except case is significant, as produced by `tools/fstr-digest.py`
+ */
+inline uint32_t updateDigest(uint32_t digest, const void* data, size_t length)
+{
+	auto p = static_cast<const uint8_t*>(data);
+	while(length-- != 0) {
+		digest = (digest ^ *p++) * prime;
+	}
+	return digest;
+}
+
+FSTR_INLINE constexpr uint8_t foldCase(uint8_t c)
+{
+	return (c >= 'A' && c <= 'Z') ? (c + 'a' - 'A') : c;
+}
+
+/**
+ * @brief Add data to a hash value
+ * @param hash Initial value, start with `offsetBasis`
+ * @param data Data to add, must be in RAM
+ * @param length Number of bytes
+ * @retval uint32_t Updated hash value
+ */
+inline uint32_t update(uint32_t hash, const void* data, size_t length)
+{
+	auto p = static_cast<const uint8_t*>(data);
+	while(length-- != 0) {
+		hash = (hash ^ foldCase(*p++)) * prime;
+	}
+	return hash;
+}
+
+/**
+ * @brief Hash a block of data in RAM
+ */
+FSTR_INLINE uint32_t calculate(const void* data, size_t length)
+{
+	return update(offsetBasis, data, length);
+}
+
+/**
+ * @brief Hash a string literal at compile time
+ * @param str
+ * @param length Number of characters in str
+ * @param hash Initial value
+ * @note Evaluated recursively, so very long strings may exceed the compiler's constexpr depth limit
+ */
+constexpr uint32_t literal(const char* str, size_t length, uint32_t hash = offsetBasis)
+{
+	return (length == 0) ? hash : literal(str + 1, length - 1, (hash ^ foldCase(*str)) * prime);
+}
+
+/**
+ * @brief Thoroughly mix bits of a hash value (MurmurHash3 finaliser)
+ */
+constexpr uint32_t mix3(uint32_t h)
+{
+	return h ^ (h >> 16);
+}
+
+constexpr uint32_t mix2(uint32_t h)
+{
+	return mix3((h ^ (h >> 13)) * 0xc2b2ae35U);
+}
+
+constexpr uint32_t mix(uint32_t h)
+{
+	return mix2((h ^ (h >> 16)) * 0x85ebca6bU);
+}
+
+} // namespace Hash
+
 } // namespace FSTR
 
 /** @} */
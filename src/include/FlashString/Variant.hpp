@@ -0,0 +1,206 @@
+/****
+ * Variant.hpp - Access objects using run-time type information
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#pragma once
+
+#include "String.hpp"
+#include <Printable.h>
+
+namespace FSTR
+{
+/**
+ * @brief Provides access to an object without knowing its C++ type
+ * @ingroup fstr_object
+ *
+ * Uses the type information stored in the object header, so requires `FSTR_TYPE_INFO=1`.
+ * Without it all objects are untyped, and appear as raw data.
+ *
+ * A Variant is just a pointer, so may be freely copied. Nested Vectors and Maps are
+ * traversed by obtaining further Variants for their content:
+ *
+ * 		FSTR::Variant config(configMap);
+ * 		auto network = config.find("network");
+ * 		for(unsigned i = 0; i < network.length(); ++i) {
+ * 			Serial.print(network.keyAt(i));
+ * 			Serial.print(" = ");
+ * 			Serial.println(network[i]);
+ * 		}
+ *
+ * No code is instantiated for each object type, and no memory is allocated.
+ */
+class Variant : public Printable
+{
+public:
+	Variant() = default;
+
+	Variant(const ObjectBase& object) : object(&object)
+	{
+	}
+
+	Variant(const ObjectBase* object) : object(object)
+	{
+	}
+
+	/**
+	 * @brief Check for a valid object
+	 */
+	explicit operator bool() const
+	{
+		return object != nullptr && !object->isNull();
+	}
+
+	Type type() const
+	{
+		return object ? object->type() : Type::none;
+	}
+
+	bool isString() const
+	{
+		return type() == Type::string;
+	}
+
+	/**
+	 * @brief Determine if the object is an Array of elementary types or structures
+	 */
+	bool isArray() const
+	{
+		auto t = type();
+		return t >= Type::character && t <= Type::structure;
+	}
+
+	bool isVector() const
+	{
+		return type() == Type::vector;
+	}
+
+	bool isMap() const
+	{
+		auto t = type();
+		return t >= Type::stringMap && t <= Type::floatMap;
+	}
+
+	/**
+	 * @brief Get the number of elements in the object
+	 * @retval size_t For Strings and untyped objects, the number of bytes
+	 */
+	size_t length() const;
+
+	/**
+	 * @brief Get the size of each element in bytes
+	 * @retval size_t For Maps, the size of the key. For untyped objects, 1.
+	 */
+	size_t elementSize() const;
+
+	/**
+	 * @brief Get a numeric value from an Array, or key from a Map
+	 * @param index
+	 * @retval int64_t 0 if the index is out of range or the element is not numeric
+	 */
+	int64_t getInt(unsigned index) const;
+
+	/**
+	 * @brief Get a numeric value from an Array, or key from a Map
+	 * @param index
+	 * @retval double 0 if the index is out of range or the element is not numeric
+	 */
+	double getFloat(unsigned index) const;
+
+	/**
+	 * @brief Get the object as a String
+	 * @retval String& String::empty() if object is not a String
+	 */
+	const String& asString() const;
+
+	/**
+	 * @brief Get a Vector element, or content of a Map entry
+	 * @param index
+	 * @retval Variant Null if the index is out of range or the object has no elements of this kind
+	 */
+	Variant valueAt(unsigned index) const;
+
+	Variant operator[](unsigned index) const
+	{
+		return valueAt(index);
+	}
+
+	/**
+	 * @brief Get the key of a Map entry with String keys
+	 * @param index
+	 * @retval Variant Referring to the key String, null if the index is out of range
+	 * @note Use `getInt()` or `getFloat()` to obtain numeric keys
+	 */
+	Variant keyAt(unsigned index) const;
+
+	/**
+	 * @brief Lookup a String key in a Map
+	 * @param key
+	 * @param ignoreCase Whether search is case-sensitive (default: true)
+	 * @retval int If key isn't found, return -1
+	 * @note This is always a linear search. The type information doesn't identify SortedMap
+	 * or HashedMap data, so their indexes are not used. Stored key hashes are checked.
+	 */
+	int indexOf(const char* key, bool ignoreCase = true) const;
+
+	/**
+	 * @brief Lookup a numeric key in a Map
+	 * @param key
+	 * @retval int If key isn't found, return -1
+	 * @note This is always a linear search, even for SortedMap data
+	 */
+	int indexOf(int64_t key) const;
+
+	int indexOf(int key) const
+	{
+		return indexOf(int64_t(key));
+	}
+
+	/**
+	 * @brief Lookup a String key and return the content, if found
+	 * @param key
+	 * @retval Variant Null if not found
+	 * @see See `indexOf()`
+	 */
+	Variant find(const char* key) const
+	{
+		return valueAt(indexOf(key));
+	}
+
+	const ObjectBase* getObject() const
+	{
+		return object;
+	}
+
+	/**
+	 * @brief Print the object content
+	 * @note Arrays and Maps are printed in the same format as Array::printTo() and Map::printTo(),
+	 * Vectors as a list of elements. Untyped objects are printed as raw data.
+	 */
+	size_t printTo(Print& p) const override;
+
+private:
+	size_t stride() const;
+	const uint8_t* elementPtr(unsigned index) const;
+	const ObjectBase* readPointer(unsigned index, size_t offset) const;
+	size_t printElement(Print& p, unsigned index) const;
+	size_t print(Print& p) const;
+
+	const ObjectBase* object = nullptr;
+};
+
+} // namespace FSTR
@@ -97,7 +97,9 @@
 	constexpr const struct {                                                                                           \
 		FSTR::ObjectBase object;                                                                                       \
 		const ObjectType* data[size];                                                                                  \
-	} name PROGMEM = {{sizeof(name.data)}, __VA_ARGS__};                                                               \
+	} name PROGMEM = {                                                                                                 \
+		{FSTR::ObjectBase::typedLength(sizeof(name.data), FSTR::Type::vector, sizeof(void*))},                         \
+		__VA_ARGS__};                                                                                                  \
 	FSTR_CHECK_STRUCT(name);
 
 namespace FSTR
@@ -113,13 +115,14 @@ public:
 	typename std::enable_if<std::is_same<T, String>::value, int>::type indexOf(const ValueType& value,
 																			   bool ignoreCase = true) const
 	{
-		if(!ignoreCase) {
-			return Object<Vector<String>, String*>::indexOf(value);
-		}
-
+		Hash::LazyKey<ValueType> valueHash(value);
 		auto len = this->length();
 		for(unsigned i = 0; i < len; ++i) {
-			if(valueAt(i).equalsIgnoreCase(value)) {
+			auto& s = valueAt(i);
+			if(!valueHash.mayMatch(s)) {
+				continue;
+			}
+			if(ignoreCase ? s.equalsIgnoreCase(value) : (s == value)) {
 				return i;
 			}
 		}
@@ -146,15 +149,20 @@ public:
 
 	/* Arduino Print support */
 
-	ArrayPrinter<Vector> printer() const
+	ArrayPrinter<Vector> printer(const PrintFormat& format = PrintFormat()) const
 	{
-		return ArrayPrinter<Vector>(*this);
+		return ArrayPrinter<Vector>(*this, format);
 	}
 
 	size_t printTo(Print& p) const
 	{
 		return printer().printTo(p);
 	}
+
+	size_t printTo(Print& p, const PrintFormat& format) const
+	{
+		return printer(format).printTo(p);
+	}
 };
 
 } // namespace FSTR
@@ -27,6 +27,111 @@
 #define FSTR_ALIGNED __attribute__((aligned(4)))
 #define FSTR_PACKED __attribute__((packed))
 
+/**
+ * @brief Size of stack buffer used by StringPrinter, determines size of each write
+ * @note Use a caller-supplied buffer for larger writes, see `String::printer()`
+ */
+#ifndef FSTR_PRINT_CHUNK_SIZE
+#define FSTR_PRINT_CHUNK_SIZE 256
+#endif
+
+/**
+ * @brief Size of stack buffer used by Array and Map printers to batch output
+ */
+#ifndef FSTR_PRINT_BUFFER_SIZE
+#define FSTR_PRINT_BUFFER_SIZE 128
+#endif
+
+/**
+ * @brief Strings up to this length are printed via the CPU cache rather than using `flashmem_read()`
+ * @note Hardware targets read flash through a cache which is shared with program code,
+ * so larger strings are read directly to avoid evicting it.
+ * Use the StringPrinter benchmark to tune this for an application.
+ */
+#ifndef FSTR_PRINT_CACHE_THRESHOLD
+#if defined(ARCH_HOST)
+// Flash content is held in ordinary memory, so there is no cache to disrupt
+#define FSTR_PRINT_CACHE_THRESHOLD 0xFFFFFFFFU
+#elif defined(ARCH_ESP32)
+// spi_flash_read() suspends the cache for each call, so it only pays off for larger strings
+#define FSTR_PRINT_CACHE_THRESHOLD 256
+#elif defined(ARCH_RP2040)
+// The XIP cache is only 16KB
+#define FSTR_PRINT_CACHE_THRESHOLD 32
+#else
+// Esp8266: 32KB cache holds all code not in IRAM
+#define FSTR_PRINT_CACHE_THRESHOLD 64
+#endif
+#endif
+
+/**
+ * @brief Size of each buffer used by AsyncStream
+ * @note Two buffers are allocated per stream
+ */
+#ifndef FSTR_ASYNC_BLOCK_SIZE
+#define FSTR_ASYNC_BLOCK_SIZE 512
+#endif
+
+/**
+ * @brief Maximum number of parts in a MultiStream
+ */
+#ifndef FSTR_MULTISTREAM_MAX_PARTS
+#define FSTR_MULTISTREAM_MAX_PARTS 8
+#endif
+
+/**
+ * @brief Set to 1 to store type information in object headers
+ * @see See `FSTR::Variant`
+ */
+#ifndef FSTR_TYPE_INFO
+#define FSTR_TYPE_INFO 0
+#endif
+
+/**
+ * @brief Set to 1 to collect access statistics for each object
+ * @see See `FSTR::Stats`
+ */
+#ifndef FSTR_STATS
+#define FSTR_STATS 0
+#endif
+
+/**
+ * @brief Maximum number of objects for which statistics are kept
+ */
+#ifndef FSTR_STATS_MAX_OBJECTS
+#define FSTR_STATS_MAX_OBJECTS 32
+#endif
+
+/**
+ * @brief Set to 1 so that `ObjectBase::read()` and `ObjectBase::readFlash()` use the active `RamCache`
+ */
+#ifndef FSTR_RAM_CACHE
+#define FSTR_RAM_CACHE 0
+#endif
+
+/**
+ * @brief Set to 1 to register all objects in a linker section so they can be validated at startup
+ * @see See `FSTR::Catalogue`
+ */
+#ifndef FSTR_CATALOGUE
+#define FSTR_CATALOGUE 0
+#endif
+
+/**
+ * @brief Set to 0 to omit the `isFlashPtr()` assertion from `ObjectBase::data()`
+ * @note The check uses `assert()`, so builds which define `NDEBUG` never make it
+ * and this setting has no effect on them.
+ * By default the check is omitted when using `FSTR_CATALOGUE`, as objects should instead
+ * be checked at startup using `FSTR::Catalogue::validate()`.
+ */
+#ifndef FSTR_CHECK_FLASH_PTR
+#if FSTR_CATALOGUE
+#define FSTR_CHECK_FLASH_PTR 0
+#else
+#define FSTR_CHECK_FLASH_PTR 1
+#endif
+#endif
+
 #ifndef ALIGNUP4
 /**
  * @brief Align a size up to the nearest word boundary
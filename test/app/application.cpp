@@ -52,8 +52,8 @@ void init()
 	Serial.begin(SERIAL_BAUD_RATE);
 	Serial.systemDebugOutput(true);
 
-	// If you need to use the filesystem
-	//	spiffs_mount();
+	// Filesystem is used for benchmarks
+	spiffs_mount();
 
 	// Enable if you need network tests
 	WifiStation.enable(false, false);
@@ -21,9 +21,43 @@
 
 #include <SmingTest.h>
 #include "data.h"
+#include <FlashString/CachedReader.hpp>
+#include <FlashString/ConcurrentReader.hpp>
+#include <FlashString/ObjectRef.hpp>
+#include <FlashString/PackedArray.hpp>
+#ifdef ARCH_HOST
+#include <thread>
+#endif
 
 namespace
 {
+/*
+ * Captures output into a buffer and counts writes
+ */
+class CapturePrint : public Print
+{
+public:
+	size_t write(uint8_t c) override
+	{
+		return write(&c, 1);
+	}
+
+	size_t write(const uint8_t* data, size_t size) override
+	{
+		++writes;
+		size = std::min(size, limit - length);
+		memcpy(&buffer[length], data, size);
+		length += size;
+		buffer[length] = '\0';
+		return size;
+	}
+
+	char buffer[256];
+	size_t length = 0;
+	size_t limit = sizeof(buffer) - 1;
+	unsigned writes = 0;
+};
+
 IMPORT_FSTR_ARRAY(custom_bin, char, COMPONENT_PATH "/files/custom.bin");
 
 enum class Fruit {
@@ -71,6 +105,25 @@ DEFINE_FSTR_ARRAY(basket, Item,
 		{Fruit::kiwi_fruit, 4, {5, 5, 5}})
 // clang-format on
 
+/*
+ * Packed from the corresponding .txt files using tools/fstr-pack.py:
+ *
+ * 	python3 ../tools/fstr-pack.py files/timestamps.txt files/timestamps.packed
+ * 	python3 ../tools/fstr-pack.py --type int16 --block-size 8 files/offsets.txt files/offsets.packed
+ */
+IMPORT_FSTR_PACKED_ARRAY_LOCAL(timestamps, uint32_t, COMPONENT_PATH "/files/timestamps.packed");
+IMPORT_FSTR_PACKED_ARRAY_LOCAL(offsets, int16_t, COMPONENT_PATH "/files/offsets.packed");
+
+uint32_t timestampAt(unsigned i)
+{
+	return 1577836800 + i * 60 + (i % 7) * 13;
+}
+
+int16_t offsetAt(unsigned i)
+{
+	return (i < 50) ? int((i * 37) % 101) - 50 : (i == 50) ? -32768 : 32767;
+}
+
 } // namespace
 
 class ArrayTest : public TestGroup
@@ -164,6 +217,294 @@ public:
 			FSTR::println(Serial, custom_bin);
 		}
 
+		TEST_CASE("Formatted print")
+		{
+			DEFINE_FSTR_ARRAY_LOCAL(hexArray, uint16_t, 0x12, 0xab, 0x1234);
+
+			CapturePrint out;
+			FSTR::PrintFormat format;
+			format.prefix = "[";
+			format.separator = ";";
+			format.suffix = "]";
+			format.base = HEX;
+			REQUIRE(hexArray.printTo(out, format) == 12);
+			REQUIRE(strcasecmp(out.buffer, "[12;ab;1234]") == 0);
+			// Output is batched
+			REQUIRE(out.writes == 1);
+
+			out = CapturePrint{};
+			REQUIRE(hexArray.printTo(out) == 15);
+			REQUIRE(strcmp(out.buffer, "{18, 171, 4660}") == 0);
+
+			// Only count what the output accepts
+			out = CapturePrint{};
+			out.limit = 10;
+			REQUIRE(hexArray.printTo(out) == 10);
+			REQUIRE(strcmp(out.buffer, "{18, 171, ") == 0);
+
+			// Each element has 3 characters plus separator
+			auto& chars = externalFSTR1.as<FSTR::Array<char>>();
+			out = CapturePrint{};
+			REQUIRE(chars.printTo(out) > chars.length() * 3);
+			REQUIRE(out.writes < chars.length());
+		}
+
+		TEST_CASE("forEachChunk")
+		{
+			auto& arr = externalFSTR1.as<FSTR::Array<uint8_t>>();
+			unsigned sum = 0;
+			for(auto c : arr) {
+				sum += c;
+			}
+
+			unsigned chunkSum = 0;
+			unsigned chunks = 0;
+			auto n = arr.forEachChunk<16>([&](const uint8_t* values, size_t count) {
+				REQUIRE(count <= 16);
+				for(unsigned i = 0; i < count; ++i) {
+					chunkSum += values[i];
+				}
+				++chunks;
+				return true;
+			});
+			REQUIRE(n == arr.length());
+			REQUIRE(chunks == (arr.length() + 15) / 16);
+			REQUIRE(chunkSum == sum);
+
+			// Stop early
+			n = arr.forEachChunk<16>([](const uint8_t*, size_t) { return false; }, 10);
+			REQUIRE(n == 16);
+
+			unsigned rows = 0;
+			tableArray.forEachChunk([&](const TableRow_Float_3* row, size_t count) {
+				for(unsigned i = 0; i < count; ++i, ++rows) {
+					REQUIRE(memcmp(&row[i], &tableArray.data()[rows], sizeof(*row)) == 0);
+				}
+				return true;
+			});
+			REQUIRE(rows == tableArray.length());
+		}
+
+		TEST_CASE("indexOf")
+		{
+			DEFINE_FSTR_ARRAY_LOCAL(bytes, uint8_t, 1, 2, 3, 4, 5, 6, 7, 0, 200, 201);
+			REQUIRE(bytes.indexOf(1) == 0);
+			REQUIRE(bytes.indexOf(0) == 7);
+			REQUIRE(bytes.indexOf(201) == 9);
+			REQUIRE(bytes.indexOf(202) < 0);
+			// Not representable as an element
+			REQUIRE(bytes.indexOf(256 + 200) < 0);
+			REQUIRE(bytes.indexOf(-56) < 0);
+
+			DEFINE_FSTR_ARRAY_LOCAL(words, int16_t, -1, 0, 1000, -1000, 32767, 9);
+			for(unsigned i = 0; i < words.length(); ++i) {
+				REQUIRE(words.indexOf(words[i]) == int(i));
+			}
+			REQUIRE(words.indexOf(65535) < 0);
+			REQUIRE(words.indexOf(8) < 0);
+			REQUIRE(words.indexOf(long(-1000)) == 3);
+			REQUIRE(FSTR::findFlash16(words.data(), words.length(), 0xffff, 1) < 0);
+			REQUIRE(FSTR::findFlash16(words.data(), words.length(), 1000, 1) == 2);
+			REQUIRE(FSTR::findFlash16(words.data(), words.length(), 9, 5) == 5);
+			REQUIRE(FSTR::findFlash16(words.data(), words.length() - 1, 9) < 0);
+
+			// Other types use element comparison
+			REQUIRE(doubleArray.indexOf(doubleArray[2]) == 2);
+			REQUIRE(int64Array.indexOf(int64Array[1]) == 1);
+		}
+
+		TEST_CASE("Random-access iterator")
+		{
+			DEFINE_FSTR_ARRAY_LOCAL(arr, int16_t, 10, 20, 30, 40, 50);
+			auto first = arr.begin();
+			auto last = arr.end();
+			REQUIRE(last - first == 5);
+			REQUIRE(std::distance(first, last) == 5);
+			REQUIRE(*(first + 2) == 30);
+			REQUIRE(*(2 + first) == 30);
+			REQUIRE(*(last - 1) == 50);
+			REQUIRE(first[3] == 40);
+			REQUIRE(first < last);
+			REQUIRE(last > first);
+			REQUIRE(first <= first);
+			REQUIRE(!(first >= last));
+			auto it = last;
+			--it;
+			it -= 2;
+			REQUIRE(*it == 30);
+			it += 1;
+			REQUIRE(*it-- == 40);
+			REQUIRE(*it == 30);
+			it = first;
+			REQUIRE(it == arr.begin());
+		}
+
+		TEST_CASE("Sorted search")
+		{
+			DEFINE_FSTR_ARRAY_LOCAL(arr, int16_t, -5, 0, 3, 3, 3, 8, 100);
+			REQUIRE(arr.lowerBound(3) == 2);
+			REQUIRE(arr.upperBound(3) == 5);
+			REQUIRE(arr.lowerBound(-10) == 0);
+			REQUIRE(arr.lowerBound(101) == arr.length());
+			REQUIRE(arr.upperBound(100) == arr.length());
+			REQUIRE(arr.lowerBound(4) == 5);
+			auto range = arr.equalRange(3);
+			REQUIRE(range.first == 2 && range.second == 5);
+			range = arr.equalRange(4);
+			REQUIRE(range.first == 5 && range.second == 5);
+			range = arr.equalRange(100);
+			REQUIRE(range.first == 6 && range.second == 7);
+			REQUIRE(arr.indexOfSorted(8) == 5);
+			REQUIRE(arr.indexOfSorted(3) == 2);
+			REQUIRE(arr.indexOfSorted(7) < 0);
+			REQUIRE(arr.indexOfSorted(1000) < 0);
+
+			// Descending order, using a custom comparison
+			DEFINE_FSTR_ARRAY_LOCAL(desc, float, 9.5, 7.25, 3, 1);
+			REQUIRE(desc.lowerBound(3, [](float e, float v) { return e > v; }) == 2);
+			REQUIRE(desc.upperBound(3, [](float v, float e) { return v > e; }) == 3);
+
+			FSTR::Array<int16_t> empty;
+			REQUIRE(empty.lowerBound(1) == 0);
+			REQUIRE(empty.indexOfSorted(1) < 0);
+		}
+
+		TEST_CASE("Interpolate")
+		{
+			DEFINE_FSTR_ARRAY_LOCAL(adc, int16_t, 0, 400, 1200, 4000);
+			DEFINE_FSTR_ARRAY_LOCAL(temperature, float, -40, 0, 50, 120);
+			REQUIRE(adc.interpolate(400, temperature) == 0);
+			REQUIRE(adc.interpolate(800, temperature) == 25);
+			REQUIRE(adc.interpolate(200, temperature) == -20);
+			REQUIRE(adc.interpolate(2600, temperature) == 85);
+			// Clamped
+			REQUIRE(adc.interpolate(-100, temperature) == -40);
+			REQUIRE(adc.interpolate(5000, temperature) == 120);
+		}
+
+		TEST_CASE("ObjectRef")
+		{
+			auto& arr = externalFSTR1.as<FSTR::Array<uint8_t>>();
+			FSTR::Array<uint8_t> copy(arr);
+			FSTR::ObjectRef<FSTR::Array<uint8_t>> ref(copy);
+			REQUIRE(ref.length() == arr.length());
+			REQUIRE(ref.data() == arr.data());
+
+			unsigned i = 0;
+			for(auto c : ref) {
+				REQUIRE(c == arr[i]);
+				++i;
+			}
+			REQUIRE(i == arr.length());
+			REQUIRE(ref[arr.length()] == 0);
+
+			uint8_t buf[16];
+			REQUIRE(ref.read(arr.length() - 8, buf, sizeof(buf)) == 8);
+			REQUIRE(memcmp(buf, &arr.data()[arr.length() - 8], 8) == 0);
+			REQUIRE(ref.readFlash(5, buf, sizeof(buf)) == sizeof(buf));
+			REQUIRE(memcmp(buf, &arr.data()[5], sizeof(buf)) == 0);
+
+			REQUIRE(FSTR::println(Serial, ref) == FSTR::println(Serial, arr));
+
+			FSTR::CachedReader<decltype(ref), 16> reader(ref);
+			REQUIRE(reader[20] == arr[20]);
+
+			FSTR::ObjectRef<FSTR::String> strRef(externalFSTR1);
+			REQUIRE(FSTR::println(Serial, strRef) == FSTR::println(Serial, externalFSTR1));
+
+			FSTR::Array<uint8_t> nullArray;
+			FSTR::ObjectRef<FSTR::Array<uint8_t>> nullRef(nullArray);
+			REQUIRE(nullRef.length() == 0);
+			REQUIRE(nullRef.begin() == nullRef.end());
+		}
+
+		TEST_CASE("CachedReader")
+		{
+			auto& arr = externalFSTR1.as<FSTR::Array<uint8_t>>();
+			FSTR::CachedReader<FSTR::Array<uint8_t>, 16> reader(arr);
+			REQUIRE(reader.length() == arr.length());
+
+			unsigned i = 0;
+			for(auto c : reader) {
+				REQUIRE(c == arr[i]);
+				++i;
+			}
+			REQUIRE(i == arr.length());
+
+			// Random access, backwards across block boundaries
+			for(int j = arr.length() - 1; j >= 0; j -= 7) {
+				REQUIRE(reader[j] == arr[j]);
+			}
+			REQUIRE(reader[arr.length()] == 0);
+
+			// Small reads straddling a block boundary
+			uint8_t buf[40];
+			REQUIRE(reader.read(12, buf, 8) == 8);
+			REQUIRE(memcmp(buf, &arr.data()[12], 8) == 0);
+			// Large reads bypass cache
+			REQUIRE(reader.read(3, buf, sizeof(buf)) == sizeof(buf));
+			REQUIRE(memcmp(buf, &arr.data()[3], sizeof(buf)) == 0);
+			// Reads are truncated at end of object
+			REQUIRE(reader.read(arr.length() - 2, buf, 8) == 2);
+
+			// Element size not a multiple of block size
+			FSTR::CachedReader<FSTR::Array<TableRow_Float_3>, 32> tableReader(tableArray);
+			i = 0;
+			for(auto row : tableReader) {
+				REQUIRE(memcmp(&row, &tableArray.data()[i], sizeof(row)) == 0);
+				++i;
+			}
+			REQUIRE(i == tableArray.length());
+		}
+
+		TEST_CASE("ConcurrentReader")
+		{
+			auto& arr = lorem.as<FSTR::Array<uint16_t>>();
+			FSTR::ConcurrentReader<FSTR::Array<uint16_t>, 32, 2> reader(arr);
+			REQUIRE(reader.length() == arr.length());
+
+			unsigned i = 0;
+			for(auto c : reader) {
+				REQUIRE(c == arr[i]);
+				++i;
+			}
+			REQUIRE(i == arr.length());
+			REQUIRE(reader[arr.length()] == 0);
+
+			// Blocks mapping to the same slot
+			for(unsigned j = 0; j < 200; j += 9) {
+				REQUIRE(reader[j] == arr[j]);
+				REQUIRE(reader[j + 32] == arr[j + 32]);
+			}
+
+			uint16_t buf[20];
+			REQUIRE(reader.read(10, buf, 12) == 12);
+			REQUIRE(memcmp(buf, &arr.data()[10], 12 * sizeof(uint16_t)) == 0);
+			REQUIRE(reader.read(arr.length() - 3, buf, 12) == 3);
+			REQUIRE(memcmp(buf, &arr.data()[arr.length() - 3], 3 * sizeof(uint16_t)) == 0);
+
+#ifdef ARCH_HOST
+			// Several threads sharing one reader
+			std::atomic<unsigned> errors{0};
+			auto scan = [&](unsigned step) {
+				for(unsigned pass = 0; pass < 20; ++pass) {
+					for(unsigned j = pass; j < arr.length(); j += step) {
+						if(reader[j] != arr[j]) {
+							++errors;
+						}
+					}
+				}
+			};
+			std::thread t1(scan, 1);
+			std::thread t2(scan, 7);
+			std::thread t3(scan, 33);
+			t1.join();
+			t2.join();
+			t3.join();
+			REQUIRE(errors == 0);
+#endif
+		}
+
 		TEST_CASE("Iterate struct with class enum")
 		{
 			for(auto item : basket) {
@@ -175,6 +516,52 @@ public:
 			REQUIRE(item.kind == Fruit::bad);
 			REQUIRE(item.count == 0);
 		}
+
+		TEST_CASE("PackedArray")
+		{
+			REQUIRE(timestamps.length() == 300);
+			REQUIRE(timestamps.blockSize() == 32);
+			// Stored using about half the space
+			REQUIRE(timestamps.ObjectBase::length() < 300 * sizeof(uint32_t) * 6 / 10);
+
+			unsigned i = 0;
+			bool ok = true;
+			for(auto v : timestamps) {
+				ok &= (v == timestampAt(i++));
+			}
+			REQUIRE(ok);
+			REQUIRE(i == 300);
+
+			for(unsigned i : {0, 1, 31, 32, 33, 150, 299}) {
+				REQUIRE(timestamps[i] == timestampAt(i));
+			}
+			REQUIRE(timestamps[300] == 0);
+			REQUIRE(timestamps.indexOf(timestampAt(100)) == 100);
+			REQUIRE(timestamps.indexOf(1) < 0);
+
+			// Bulk decode, spanning blocks
+			uint32_t buffer[40];
+			REQUIRE(timestamps.read(280, buffer, 40) == 20);
+			REQUIRE(timestamps.read(60, buffer, 40) == 40);
+			for(unsigned i = 0; i < 40; ++i) {
+				ok &= (buffer[i] == timestampAt(60 + i));
+			}
+			REQUIRE(ok);
+
+			REQUIRE(offsets.length() == 52);
+			i = 0;
+			for(auto v : offsets) {
+				ok &= (v == offsetAt(i++));
+			}
+			REQUIRE(ok);
+			REQUIRE(offsets[50] == -32768);
+			REQUIRE(offsets[51] == 32767);
+
+			// Element type must match
+			auto& wrongType = timestamps.as<FSTR::PackedArray<uint16_t>>();
+			REQUIRE(wrongType.length() == 0);
+			REQUIRE(wrongType.begin() == wrongType.end());
+		}
 	}
 };
 
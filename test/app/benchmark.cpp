@@ -0,0 +1,248 @@
+/**
+ * benchmark.cpp
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#include <SmingTest.h>
+#include "data.h"
+#include <FlashString/Stream.hpp>
+#include <Data/Stream/FileStream.h>
+
+namespace
+{
+// List of keys in case-insensitive order, as required for SortedMap
+#define KEY_MAP_8(XX) XX(0) XX(1) XX(2) XX(3) XX(4) XX(5) XX(6) XX(7)
+#define KEY_MAP_32(XX)                                                                                                 \
+	XX(0) XX(1) XX(10) XX(11) XX(12) XX(13) XX(14) XX(15) XX(16) XX(17) XX(18) XX(19) XX(2) XX(20) XX(21) XX(22)       \
+	XX(23) XX(24) XX(25) XX(26) XX(27) XX(28) XX(29) XX(3) XX(30) XX(31) XX(4) XX(5) XX(6) XX(7) XX(8) XX(9)
+
+#define XX(n) DEFINE_FSTR_LOCAL(key##n, "key" #n);
+KEY_MAP_32(XX)
+#undef XX
+
+#define XX(n) {&key##n, &key##n},
+DEFINE_FSTR_MAP_LOCAL(map8, FSTR::String, FSTR::String, KEY_MAP_8(XX));
+DEFINE_FSTR_MAP_LOCAL(map32, FSTR::String, FSTR::String, KEY_MAP_32(XX));
+DEFINE_FSTR_MAP_SORTED_LOCAL(sortedMap8, FSTR::String, FSTR::String, KEY_MAP_8(XX));
+DEFINE_FSTR_MAP_SORTED_LOCAL(sortedMap32, FSTR::String, FSTR::String, KEY_MAP_32(XX));
+#undef XX
+
+#define XX(n) &key##n,
+DEFINE_FSTR_VECTOR_LOCAL(vector32, FSTR::String, KEY_MAP_32(XX));
+#undef XX
+
+/*
+ * Discards output
+ */
+class NullPrint : public Print
+{
+public:
+	size_t write(uint8_t) override
+	{
+		return 1;
+	}
+
+	size_t write(const uint8_t*, size_t size) override
+	{
+		return size;
+	}
+};
+
+/*
+ * Run a function repeatedly and print timing information
+ * bytes is the amount of data processed by each call, or 0 if not applicable
+ */
+template <typename Func> void measure(const char* title, unsigned iterations, size_t bytes, Func func)
+{
+	auto start = micros();
+	for(unsigned i = 0; i < iterations; ++i) {
+		func();
+	}
+	auto elapsed = micros() - start;
+
+	auto cycles = uint64_t(elapsed) * system_get_cpu_freq() / iterations;
+	Serial.printf(_F("  %-40s %8u us, %8u cycles per iteration"), title, unsigned(elapsed), unsigned(cycles));
+	if(bytes != 0 && elapsed != 0) {
+		// Bytes per millisecond, so result doesn't overflow on Host
+		Serial.printf(_F(", %8u KB/sec"), unsigned(uint64_t(bytes) * iterations * 1000 / elapsed));
+	}
+	Serial.println();
+}
+
+constexpr unsigned iterations = 100;
+
+} // namespace
+
+class BenchmarkTest : public TestGroup
+{
+public:
+	BenchmarkTest() : TestGroup(_F("Benchmark"))
+	{
+	}
+
+	void execute() override
+	{
+		TEST_CASE("read vs. readFlash")
+		{
+			char buffer[1024];
+			for(size_t chunkSize : {16, 64, 256, 1024}) {
+				auto readAll = [&](bool flash) {
+					size_t offset = 0;
+					size_t count;
+					while((count = flash ? lorem.readFlash(offset, buffer, chunkSize)
+										 : lorem.read(offset, buffer, chunkSize)) != 0) {
+						offset += count;
+					}
+					REQUIRE(offset == lorem.length());
+				};
+
+				String title = F("read, chunk size ");
+				title += chunkSize;
+				measure(title.c_str(), iterations, lorem.length(), [&]() { readAll(false); });
+				title = F("readFlash, chunk size ");
+				title += chunkSize;
+				measure(title.c_str(), iterations, lorem.length(), [&]() { readAll(true); });
+			}
+		}
+
+		TEST_CASE("StringPrinter")
+		{
+			NullPrint out;
+			measure(_F("printTo, large String"), iterations, lorem.length(),
+					[&]() { REQUIRE(lorem.printTo(out) == lorem.length()); });
+			measure(_F("printTo, small String"), iterations, externalFSTR1.length(),
+					[&]() { REQUIRE(externalFSTR1.printTo(out) == externalFSTR1.length()); });
+		}
+
+		TEST_CASE("Map::indexOf")
+		{
+			String first = F("key0");
+			String last = F("key9");
+			measure(_F("Map[8], first key"), iterations, 0, [&]() { REQUIRE(map8.indexOf(first) == 0); });
+			measure(_F("Map[8], missing key"), iterations, 0, [&]() { REQUIRE(map8.indexOf(last) < 0); });
+			measure(_F("Map[32], first key"), iterations, 0, [&]() { REQUIRE(map32.indexOf(first) == 0); });
+			measure(_F("Map[32], last key"), iterations, 0, [&]() { REQUIRE(map32.indexOf(last) == 31); });
+			measure(_F("SortedMap[8], missing key"), iterations, 0,
+					[&]() { REQUIRE(sortedMap8.indexOf(last) < 0); });
+			measure(_F("SortedMap[32], last key"), iterations, 0,
+					[&]() { REQUIRE(sortedMap32.indexOf(last) == 31); });
+			String header = F("If-None-Match");
+			measure(_F("HashedMap[10]"), iterations, 0, [&]() { REQUIRE(hashedMap.indexOf(header) >= 0); });
+		}
+
+		TEST_CASE("Vector<String>::indexOf")
+		{
+			String last = F("key9");
+			String lastUpper = F("KEY9");
+			measure(_F("Vector[32], case-sensitive"), iterations, 0,
+					[&]() { REQUIRE(vector32.indexOf(last, false) == 31); });
+			measure(_F("Vector[32], ignore case"), iterations, 0,
+					[&]() { REQUIRE(vector32.indexOf(lastUpper, true) == 31); });
+		}
+
+		TEST_CASE("String::indexOf")
+		{
+			auto last = lorem.length() - 1;
+			char c = lorem[last];
+			auto expected = lorem.indexOf(c);
+			measure(_F("valueAt() per character"), iterations, lorem.length(), [&]() {
+				unsigned i = 0;
+				while(i < lorem.length() && lorem.valueAt(i) != c) {
+					++i;
+				}
+				REQUIRE(int(i) == expected);
+			});
+			measure(_F("indexOf(char)"), iterations, lorem.length(), [&]() { REQUIRE(lorem.indexOf(c) == expected); });
+			measure(_F("indexOf(\"missing\")"), iterations, lorem.length(),
+					[&]() { REQUIRE(lorem.indexOf("missing") < 0); });
+		}
+
+		TEST_CASE("FileMap vs. SPIFFS")
+		{
+			char buffer[256];
+			auto readStream = [&](IDataSourceStream* stream) {
+				REQUIRE(stream != nullptr);
+				size_t total = 0;
+				size_t count;
+				while((count = stream->readMemoryBlock(buffer, sizeof(buffer))) != 0) {
+					stream->seek(count);
+					total += count;
+				}
+				delete stream;
+				return total;
+			};
+
+			String path = F("css/style.css");
+			measure(_F("FileMap::find"), iterations, 0, [&]() { REQUIRE(webFiles.find(path)); });
+			auto file = webFiles.find(path);
+			measure(_F("FileMap::open, uncompressed"), iterations, file.size(),
+					[&]() { REQUIRE(readStream(webFiles.open(path)) == file.size()); });
+			file = webFiles.find("index.html");
+			measure(_F("FileMap::open, LZSS"), iterations, file.size(),
+					[&]() { REQUIRE(readStream(webFiles.open("index.html")) == file.size()); });
+
+			if(!fileExist(_F("lorem.txt"))) {
+				Serial.println(_F("  SPIFFS file not found, skipping"));
+			} else {
+				measure(_F("SPIFFS open"), iterations, 0, [&]() {
+					FileStream stream(_F("lorem.txt"));
+					REQUIRE(stream.isValid());
+				});
+			}
+		}
+
+		TEST_CASE("FSTR::Stream vs. SPIFFS")
+		{
+			char buffer[256];
+			auto readStream = [&](IDataSourceStream& stream) {
+				size_t total = 0;
+				while(!stream.isFinished()) {
+					auto count = stream.readMemoryBlock(buffer, sizeof(buffer));
+					if(count == 0) {
+						break;
+					}
+					stream.seek(count);
+					total += count;
+				}
+				return total;
+			};
+
+			measure(_F("FSTR::Stream, flashread"), iterations, lorem.length(), [&]() {
+				FSTR::Stream stream(lorem);
+				REQUIRE(readStream(stream) == lorem.length());
+			});
+			measure(_F("FSTR::Stream, cached"), iterations, lorem.length(), [&]() {
+				FSTR::Stream stream(lorem, false);
+				REQUIRE(readStream(stream) == lorem.length());
+			});
+
+			if(!fileExist(_F("lorem.txt"))) {
+				Serial.println(_F("  SPIFFS file not found, skipping"));
+			} else {
+				measure(_F("FileStream"), iterations, lorem.length(), [&]() {
+					FileStream stream(_F("lorem.txt"));
+					REQUIRE(readStream(stream) == lorem.length());
+				});
+			}
+		}
+	}
+};
+
+void REGISTER_TEST(benchmark)
+{
+	registerGroup<BenchmarkTest>();
+}
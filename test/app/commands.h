@@ -0,0 +1,40 @@
+// Generated by fstr-prefix.py, do not edit
+
+#include <FlashString/PrefixVector.hpp>
+
+DEFINE_FSTR_LOCAL(commands_0, "help");
+DEFINE_FSTR_LOCAL(commands_1, "status");
+DEFINE_FSTR_LOCAL(commands_2, "/api/");
+DEFINE_FSTR_LOCAL(commands_3, "/api/v1/");
+DEFINE_FSTR_LOCAL(commands_4, "/api/v1/config");
+DEFINE_FSTR_LOCAL(commands_5, "/");
+DEFINE_FSTR_LOCAL(commands_6, "Set");
+DEFINE_FSTR_LOCAL(commands_7, "setup");
+DEFINE_FSTR_LOCAL(commands_8, "reset");
+DEFINE_FSTR_LOCAL(commands_9, "restart");
+DEFINE_FSTR_LOCAL(commands_10, "show");
+DEFINE_FSTR_LOCAL(commands_11, "show-all");
+DEFINE_FSTR_LOCAL(commands_12, "sh");
+DEFINE_FSTR_LOCAL(commands_13, "wifi");
+DEFINE_FSTR_LOCAL(commands_14, "wifi-scan");
+DEFINE_FSTR_LOCAL(commands_15, "WIFI-connect");
+DEFINE_FSTR_LOCAL(commands_16, "exit");
+DEFINE_FSTR_ARRAY_LOCAL(commands_index, uint16_t, 5, 2, 3, 4, 16, 0, 8, 9, 6, 7, 12, 10, 11, 1, 13, 15, 14);
+DEFINE_FSTR_VECTOR_PREFIXED_LOCAL(commands, &commands_index,
+	&commands_0,
+	&commands_1,
+	&commands_2,
+	&commands_3,
+	&commands_4,
+	&commands_5,
+	&commands_6,
+	&commands_7,
+	&commands_8,
+	&commands_9,
+	&commands_10,
+	&commands_11,
+	&commands_12,
+	&commands_13,
+	&commands_14,
+	&commands_15,
+	&commands_16);
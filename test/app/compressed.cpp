@@ -0,0 +1,135 @@
+/**
+ * compressed.cpp
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#include <SmingTest.h>
+#include "data.h"
+#include <FlashString/CompressedStream.hpp>
+
+namespace
+{
+// Files generated using tools/fstr-compress.py
+IMPORT_FSTR_COMPRESSED_LOCAL(loremLzss, COMPONENT_PATH "/files/lorem.lzss");
+IMPORT_FSTR_COMPRESSED_LOCAL(loremGzip, COMPONENT_PATH "/files/lorem.gz");
+
+// Read entire stream using the given buffer size and compare with original
+bool verifyStream(IDataSourceStream& stream, const FSTR::String& content, size_t bufSize)
+{
+	char buffer[200];
+	char expected[200];
+	size_t offset = 0;
+	while(!stream.isFinished()) {
+		auto count = stream.readMemoryBlock(buffer, bufSize);
+		if(count == 0 || content.read(offset, expected, count) != count || memcmp(buffer, expected, count) != 0) {
+			return false;
+		}
+		offset += count;
+		stream.seek(count);
+	}
+
+	return offset == content.length();
+}
+
+} // namespace
+
+class CompressedTest : public TestGroup
+{
+public:
+	CompressedTest() : TestGroup(_F("Compressed"))
+	{
+	}
+
+	void execute() override
+	{
+		TEST_CASE("LZSS header")
+		{
+			REQUIRE(loremLzss.method() == FSTR::Compression::lzss);
+			REQUIRE(loremLzss.uncompressedLength() == lorem.length());
+			REQUIRE(loremLzss.length() < lorem.length());
+		}
+
+		TEST_CASE("LZSS stream")
+		{
+			for(auto bufSize : {1, 7, 64, 200}) {
+				FSTR::CompressedStream stream(loremLzss);
+				REQUIRE(stream.isValid());
+				REQUIRE(stream.getContentEncoding() == nullptr);
+				REQUIRE(size_t(stream.available()) == lorem.length());
+				REQUIRE(verifyStream(stream, lorem, bufSize));
+			}
+		}
+
+		TEST_CASE("LZSS seek")
+		{
+			FSTR::CompressedStream stream(loremLzss);
+			char buffer[16];
+			char expected[16];
+
+			// Forward
+			REQUIRE(stream.seekFrom(3000, SeekOrigin::Start) == 3000);
+			REQUIRE(stream.readMemoryBlock(buffer, sizeof(buffer)) == sizeof(buffer));
+			lorem.read(3000, expected, sizeof(expected));
+			REQUIRE(memcmp(buffer, expected, sizeof(buffer)) == 0);
+
+			// Back, within window
+			REQUIRE(stream.seekFrom(-100, SeekOrigin::Current) == 2900);
+			REQUIRE(stream.readMemoryBlock(buffer, sizeof(buffer)) == sizeof(buffer));
+			lorem.read(2900, expected, sizeof(expected));
+			REQUIRE(memcmp(buffer, expected, sizeof(buffer)) == 0);
+
+			// Back to start
+			REQUIRE(stream.seekFrom(0, SeekOrigin::Start) == 0);
+			REQUIRE(verifyStream(stream, lorem, sizeof(buffer)));
+
+			REQUIRE(stream.seekFrom(1, SeekOrigin::End) < 0);
+		}
+
+		TEST_CASE("gzip passthrough")
+		{
+			REQUIRE(loremGzip.method() == FSTR::Compression::gzip);
+			FSTR::CompressedStream stream(loremGzip);
+			REQUIRE(stream.isValid());
+			REQUIRE(strcmp(stream.getContentEncoding(), "gzip") == 0);
+			REQUIRE(size_t(stream.available()) == loremGzip.contentLength());
+			char buffer[2];
+			REQUIRE(stream.readMemoryBlock(buffer, sizeof(buffer)) == 2);
+			// gzip magic
+			REQUIRE(buffer[0] == '\x1f');
+			REQUIRE(buffer[1] == '\x8b');
+		}
+
+		TEST_CASE("Invalid")
+		{
+			auto& notCompressed = lorem.as<FSTR::Compressed>();
+			FSTR::CompressedStream stream(notCompressed);
+			REQUIRE(!stream.isValid());
+			REQUIRE(stream.available() == 0);
+		}
+
+		TEST_CASE("Print")
+		{
+			REQUIRE(loremLzss.printTo(Serial) == lorem.length());
+			Serial.println();
+		}
+	}
+};
+
+void REGISTER_TEST(compressed)
+{
+	registerGroup<CompressedTest>();
+}
@@ -28,6 +28,8 @@
 
 DEFINE_FSTR(externalFSTR1, EXTERNAL_FSTR1_TEXT)
 
+IMPORT_FSTR(lorem, COMPONENT_PATH "/files/lorem.txt");
+
 /**
  * Array
  */
@@ -44,10 +46,18 @@ DEFINE_FSTR_LOCAL(data1, "Test string #1");
 DEFINE_FSTR_LOCAL(data2, "Test string #2");
 DEFINE_FSTR_VECTOR(stringVector, FSTR::String, &data1, nullptr, &data2);
 
+DEFINE_FSTR_HASHED_LOCAL(hashedGet, "GET");
+DEFINE_FSTR_HASHED_LOCAL(hashedPut, "PUT");
+DEFINE_FSTR_HASHED_LOCAL(hashedPost, "POST");
+DEFINE_FSTR_HASHED_LOCAL(hashedHead, "HEAD");
+DEFINE_FSTR_VECTOR(hashedVector, FSTR::String, &hashedGet, &hashedPut, &hashedPost, &hashedHead);
+
 DEFINE_FSTR_ARRAY_LOCAL(row1, float, 1, 2, 3);
 DEFINE_FSTR_ARRAY_LOCAL(row2, float, 4, 5, 6, 7, 8, 9, 10);
 DEFINE_FSTR_VECTOR(arrayVector, FSTR::Array<float>, &row1, &row2);
 
+DEFINE_FSTR_VECTOR(pooledVector, FSTR::String, &pooledJson, &pooledEscape);
+
 /**
  * Map
  */
@@ -66,3 +76,41 @@ DEFINE_FSTR_MAP(enumMap, MapKey, FSTR::String, {KeyA, &FS_content1}, {KeyB, &FS_
 
 // Note the use of FSTR_PTR(), required for GCC 4.8.5 because stringVector is a global reference and therefore not constexpr
 DEFINE_FSTR_MAP(vectorMap, FSTR::String, FSTR::Vector<FSTR::String>, {&key1, FSTR_PTR(stringVector)});
+
+// Sorted maps
+
+DEFINE_FSTR_MAP_SORTED(sortedIntMap, int, FSTR::String, {-5, &key1}, {0, &key2}, {12, &key1}, {1000, &key2});
+
+DEFINE_FSTR_LOCAL(keyAccept, "Accept");
+DEFINE_FSTR_LOCAL(keyContentType, "Content-Type");
+DEFINE_FSTR_LOCAL(keyContentTypeLower, "content-type");
+DEFINE_FSTR_LOCAL(keyHost, "Host");
+DEFINE_FSTR_LOCAL(keyUserAgent, "User-Agent");
+DEFINE_FSTR_MAP_SORTED(sortedStringMap, FSTR::String, FSTR::String, {&keyAccept, &key1}, {&keyContentType, &key1},
+					   {&keyContentTypeLower, &key2}, {&keyHost, &key1}, {&keyUserAgent, &key2});
+
+// Hashed map, created from a list of `key content` lines using tools/maphash.py
+
+// Generated by maphash.py, do not edit
+DEFINE_FSTR_LOCAL(hashedMap_key0, "Accept");
+DEFINE_FSTR_LOCAL(hashedMap_key1, "Accept-Encoding");
+DEFINE_FSTR_LOCAL(hashedMap_key2, "Content-Type");
+DEFINE_FSTR_LOCAL(hashedMap_key3, "Content-Length");
+DEFINE_FSTR_LOCAL(hashedMap_key4, "Host");
+DEFINE_FSTR_LOCAL(hashedMap_key5, "User-Agent");
+DEFINE_FSTR_LOCAL(hashedMap_key6, "Connection");
+DEFINE_FSTR_LOCAL(hashedMap_key7, "Cache-Control");
+DEFINE_FSTR_LOCAL(hashedMap_key8, "ETag");
+DEFINE_FSTR_LOCAL(hashedMap_key9, "If-None-Match");
+DEFINE_FSTR_ARRAY_LOCAL(hashedMap_index, int16_t, -2, -5, 1, 0, 3);
+DEFINE_FSTR_MAP_HASHED(hashedMap, FSTR::String, 0, &hashedMap_index,
+	{&hashedMap_key0, &key1},
+	{&hashedMap_key8, &key1},
+	{&hashedMap_key7, &key2},
+	{&hashedMap_key9, &key2},
+	{&hashedMap_key1, &key2},
+	{&hashedMap_key4, &key1},
+	{&hashedMap_key2, &key1},
+	{&hashedMap_key6, &key1},
+	{&hashedMap_key3, &key2},
+	{&hashedMap_key5, &key2});
@@ -26,6 +26,9 @@
 #include <FlashString/Table.hpp>
 #include <FlashString/Vector.hpp>
 #include <FlashString/Map.hpp>
+#include <FlashString/SortedMap.hpp>
+#include <FlashString/HashedMap.hpp>
+#include <FlashString/FileMap.hpp>
 
 /**
  * String
@@ -34,6 +37,14 @@
 #define EXTERNAL_FSTR1_TEXT "This is an external flash string\0two\0three\0four"
 DECLARE_FSTR(externalFSTR1);
 
+// Large text file, also stored in SPIFFS
+DECLARE_FSTR(lorem);
+
+// Pooled strings are stored once, however many modules include this header
+#define POOLED_ESCAPE_TEXT "Quote \" tab \t octal \101"
+DEFINE_FSTR_POOLED(pooledJson, "application/json")
+DEFINE_FSTR_POOLED(pooledEscape, POOLED_ESCAPE_TEXT)
+
 /**
  * Array
  */
@@ -49,7 +60,9 @@ DECLARE_FSTR_ARRAY(tableArray, TableRow_Float_3);
  */
 
 DECLARE_FSTR_VECTOR(stringVector, FSTR::String);
+DECLARE_FSTR_VECTOR(hashedVector, FSTR::String);
 DECLARE_FSTR_VECTOR(arrayVector, FSTR::Array<float>);
+DECLARE_FSTR_VECTOR(pooledVector, FSTR::String);
 
 /**
  * Map
@@ -65,3 +78,17 @@ DECLARE_FSTR_MAP(enumMap, MapKey, FSTR::String);
 DECLARE_FSTR_MAP(stringMap, FSTR::String, FSTR::String);
 DECLARE_FSTR_MAP(arrayMap, int, FSTR::Array<float>);
 DECLARE_FSTR_MAP(vectorMap, FSTR::String, FSTR::Vector<FSTR::String>);
+DECLARE_FSTR_MAP_SORTED(sortedIntMap, int, FSTR::String);
+DECLARE_FSTR_MAP_SORTED(sortedStringMap, FSTR::String, FSTR::String);
+DECLARE_FSTR_MAP_HASHED(hashedMap, FSTR::String);
+
+/**
+ * FileMap
+ */
+
+/*
+ * Generated from files/www using tools/filemap.py, see webfiles.cpp:
+ *
+ * 	python3 ../tools/filemap.py webFiles files/www --prefix COMPONENT_PATH --compress lzss --output-dir files/www.fstr
+ */
+DECLARE_FSTR_FILEMAP(webFiles);
@@ -0,0 +1,114 @@
+/**
+ * filemap.cpp
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#include <SmingTest.h>
+#include "data.h"
+#include <memory>
+
+namespace
+{
+// Original content, for comparison
+IMPORT_FSTR_LOCAL(indexHtml, COMPONENT_PATH "/files/www/index.html");
+IMPORT_FSTR_LOCAL(styleCss, COMPONENT_PATH "/files/www/css/style.css");
+
+bool verifyStream(IDataSourceStream& stream, const FSTR::String& content)
+{
+	char buffer[64];
+	char expected[64];
+	size_t offset = 0;
+	while(!stream.isFinished()) {
+		auto count = stream.readMemoryBlock(buffer, sizeof(buffer));
+		if(count == 0 || content.read(offset, expected, count) != count || memcmp(buffer, expected, count) != 0) {
+			return false;
+		}
+		offset += count;
+		stream.seek(count);
+	}
+
+	return offset == content.length();
+}
+
+} // namespace
+
+class FileMapTest : public TestGroup
+{
+public:
+	FileMapTest() : TestGroup(_F("FileMap"))
+	{
+	}
+
+	void execute() override
+	{
+		TEST_CASE("Lookup")
+		{
+			REQUIRE(webFiles.length() == 3);
+			for(auto entry : webFiles) {
+				REQUIRE(webFiles.indexOf(entry.path()) >= 0);
+				REQUIRE(webFiles[entry.path()].path() == entry.path());
+			}
+
+			auto css = webFiles.find("css/style.css");
+			REQUIRE(css);
+			REQUIRE(css.mimeType() == "text/css");
+			REQUIRE(css.size() == styleCss.length());
+			REQUIRE(css.compression() == FSTR::Compression::none);
+			REQUIRE(css.contentEncoding() == nullptr);
+
+			REQUIRE(!webFiles.find("CSS/STYLE.CSS"));
+			REQUIRE(webFiles.find("CSS/STYLE.CSS", true));
+			REQUIRE(!webFiles.find("missing.html"));
+			REQUIRE(!webFiles["css"]);
+			REQUIRE(webFiles.open("missing.html") == nullptr);
+		}
+
+		TEST_CASE("Compressed content")
+		{
+			auto index = webFiles.find(F("index.html"));
+			REQUIRE(index);
+			REQUIRE(index.mimeType() == "text/html");
+			REQUIRE(index.compression() == FSTR::Compression::lzss);
+			REQUIRE(index.size() == indexHtml.length());
+			REQUIRE(index.content().length() < indexHtml.length());
+			// ETag is derived from the original content
+			REQUIRE(index.etag() != webFiles.find("info.json").etag());
+		}
+
+		TEST_CASE("open")
+		{
+			std::unique_ptr<IDataSourceStream> stream(webFiles.open("index.html"));
+			REQUIRE(stream);
+			REQUIRE(size_t(stream->available()) == indexHtml.length());
+			REQUIRE(verifyStream(*stream, indexHtml));
+
+			stream.reset(webFiles.open(String("css/style.css")));
+			REQUIRE(stream);
+			REQUIRE(verifyStream(*stream, styleCss));
+		}
+
+		TEST_CASE("printTo")
+		{
+			REQUIRE(webFiles.printTo(Serial) != 0);
+		}
+	}
+};
+
+void REGISTER_TEST(filemap)
+{
+	registerGroup<FileMapTest>();
+}
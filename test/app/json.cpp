@@ -0,0 +1,112 @@
+/**
+ * json.cpp
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#include <SmingTest.h>
+#include <FlashString/Variant.hpp>
+
+// Generated from files/config.json using tools/json2fstr.py
+#include "jsonconfig.h"
+// Generated from files/flat.json, root type is not used elsewhere in the document
+#include "jsonflat.h"
+
+class JsonTest : public TestGroup
+{
+public:
+	JsonTest() : TestGroup(_F("JSON"))
+	{
+	}
+
+	void execute() override
+	{
+		TEST_CASE("Typed access")
+		{
+			REQUIRE(jsonConfig.length() == 12);
+			// Keys are sorted
+			REQUIRE(jsonConfig.valueAt(0).key() == "colours");
+			REQUIRE(jsonConfig.indexOf("Name") == 3);
+			REQUIRE(jsonConfig.indexOf("missing") < 0);
+			REQUIRE(jsonConfig.indexOf("none") >= 0);
+			REQUIRE(!jsonConfig["none"]);
+			// Mixed content
+			REQUIRE(jsonConfig["name"].content().length() == 16);
+			REQUIRE(jsonConfig["none"].content().isNull());
+			REQUIRE(jsonConfig.printTo(Serial) != 0);
+			Serial.println();
+		}
+
+		TEST_CASE("Header declaration")
+		{
+			REQUIRE(jsonFlat.length() == 2);
+			REQUIRE(jsonFlat["b"].content() == "y");
+			REQUIRE(jsonFlat.printTo(Serial) != 0);
+			Serial.println();
+		}
+
+#if FSTR_TYPE_INFO
+		TEST_CASE("Variant access")
+		{
+			FSTR::Variant config(jsonConfig);
+			REQUIRE(config.isMap());
+			REQUIRE(config.find("name").asString() == "FlashString test");
+			REQUIRE(config.find("version").getInt(0) == 3);
+			REQUIRE(config.find("debug").getInt(0) == 0);
+			REQUIRE(config.find("ratio").getFloat(0) == 0.75);
+			REQUIRE(config.find("serial").getInt(0) == 12345678901LL);
+			REQUIRE(!config.find("none"));
+
+			auto network = config.find("network");
+			REQUIRE(network.length() == 3);
+			REQUIRE(network.find("ssid").asString() == "MyNetwork");
+			REQUIRE(network.find("dhcp").getInt(0) == 1);
+
+			auto servers = config.find("servers");
+			REQUIRE(servers.isVector());
+			REQUIRE(servers.length() == 2);
+			REQUIRE(servers[1].find("host").asString() == "two.example.com");
+			REQUIRE(servers[1].find("port").getInt(0) == 8080);
+
+			auto ports = config.find("ports");
+			REQUIRE(ports.isArray());
+			REQUIRE(ports.length() == 3);
+			REQUIRE(ports.getInt(1) == 443);
+
+			auto empty = config.find("empty");
+			REQUIRE(empty.isVector());
+			REQUIRE(empty.length() == 0);
+		}
+
+		TEST_CASE("Shared content")
+		{
+			FSTR::Variant config(jsonConfig);
+			// Identical strings are only stored once
+			auto tags = config.find("tags");
+			REQUIRE(tags.length() == 3);
+			REQUIRE(tags[0].getObject() == tags[2].getObject());
+			// Homogeneous content is typed
+			auto& colours = config.find("colours").getObject()->as<FSTR::SortedMap<FSTR::String, FSTR::String>>();
+			REQUIRE(colours["GREEN"].content() == "#0f0");
+		}
+#endif
+	}
+};
+
+void REGISTER_TEST(json)
+{
+	registerGroup<JsonTest>();
+}
@@ -0,0 +1,76 @@
+// Generated by json2fstr.py, do not edit
+
+#include "jsonconfig.h"
+
+#if !FSTR_TYPE_INFO
+#warning "Mixed content requires FSTR_TYPE_INFO=1 for access using FSTR::Variant"
+#endif
+
+DEFINE_FSTR_LOCAL(jsonConfig_str0, "FlashString test");
+DEFINE_FSTR_ARRAY_LOCAL(jsonConfig_arr0, int32_t, 3);
+DEFINE_FSTR_ARRAY_LOCAL(jsonConfig_arr1, bool, false);
+DEFINE_FSTR_ARRAY_LOCAL(jsonConfig_arr2, double, 0.75);
+DEFINE_FSTR_ARRAY_LOCAL(jsonConfig_arr3, int64_t, 12345678901LL);
+DEFINE_FSTR_LOCAL(jsonConfig_str1, "MyNetwork");
+DEFINE_FSTR_LOCAL(jsonConfig_str2, "secret");
+DEFINE_FSTR_ARRAY_LOCAL(jsonConfig_arr4, bool, true);
+DEFINE_FSTR_LOCAL(jsonConfig_str3, "ssid");
+DEFINE_FSTR_LOCAL(jsonConfig_str4, "password");
+DEFINE_FSTR_LOCAL(jsonConfig_str5, "dhcp");
+DEFINE_FSTR_MAP_SORTED_LOCAL(jsonConfig_map0, FSTR::String, FSTR::ObjectBase,
+	{&jsonConfig_str5, &FSTR_DATA_NAME(jsonConfig_arr4).object},
+	{&jsonConfig_str4, &FSTR_DATA_NAME(jsonConfig_str2).object},
+	{&jsonConfig_str3, &FSTR_DATA_NAME(jsonConfig_str1).object});
+DEFINE_FSTR_LOCAL(jsonConfig_str6, "one.example.com");
+DEFINE_FSTR_ARRAY_LOCAL(jsonConfig_arr5, int32_t, 80);
+DEFINE_FSTR_LOCAL(jsonConfig_str7, "host");
+DEFINE_FSTR_LOCAL(jsonConfig_str8, "port");
+DEFINE_FSTR_MAP_SORTED_LOCAL(jsonConfig_map1, FSTR::String, FSTR::ObjectBase,
+	{&jsonConfig_str7, &FSTR_DATA_NAME(jsonConfig_str6).object},
+	{&jsonConfig_str8, &FSTR_DATA_NAME(jsonConfig_arr5).object});
+DEFINE_FSTR_LOCAL(jsonConfig_str9, "two.example.com");
+DEFINE_FSTR_ARRAY_LOCAL(jsonConfig_arr6, int32_t, 8080);
+DEFINE_FSTR_MAP_SORTED_LOCAL(jsonConfig_map2, FSTR::String, FSTR::ObjectBase,
+	{&jsonConfig_str7, &FSTR_DATA_NAME(jsonConfig_str9).object},
+	{&jsonConfig_str8, &FSTR_DATA_NAME(jsonConfig_arr6).object});
+DEFINE_FSTR_VECTOR_LOCAL(jsonConfig_vec0, jsonConfig_type0, &jsonConfig_map1, &jsonConfig_map2);
+DEFINE_FSTR_ARRAY_LOCAL(jsonConfig_arr7, int32_t, 80, 443, 8080);
+DEFINE_FSTR_LOCAL(jsonConfig_str10, "alpha");
+DEFINE_FSTR_LOCAL(jsonConfig_str11, "beta");
+DEFINE_FSTR_VECTOR_LOCAL(jsonConfig_vec1, FSTR::String, &jsonConfig_str10, &jsonConfig_str11, &jsonConfig_str10);
+DEFINE_FSTR_LOCAL(jsonConfig_str12, "#f00");
+DEFINE_FSTR_LOCAL(jsonConfig_str13, "#0f0");
+DEFINE_FSTR_LOCAL(jsonConfig_str14, "#00f");
+DEFINE_FSTR_LOCAL(jsonConfig_str15, "Red");
+DEFINE_FSTR_LOCAL(jsonConfig_str16, "green");
+DEFINE_FSTR_LOCAL(jsonConfig_str17, "Blue");
+DEFINE_FSTR_MAP_SORTED_LOCAL(jsonConfig_map3, FSTR::String, FSTR::String,
+	{&jsonConfig_str17, &jsonConfig_str14},
+	{&jsonConfig_str16, &jsonConfig_str13},
+	{&jsonConfig_str15, &jsonConfig_str12});
+DEFINE_FSTR_VECTOR_SIZED_LOCAL(jsonConfig_vec2, FSTR::ObjectBase, 0);
+DEFINE_FSTR_LOCAL(jsonConfig_str18, "name");
+DEFINE_FSTR_LOCAL(jsonConfig_str19, "version");
+DEFINE_FSTR_LOCAL(jsonConfig_str20, "debug");
+DEFINE_FSTR_LOCAL(jsonConfig_str21, "ratio");
+DEFINE_FSTR_LOCAL(jsonConfig_str22, "serial");
+DEFINE_FSTR_LOCAL(jsonConfig_str23, "network");
+DEFINE_FSTR_LOCAL(jsonConfig_str24, "servers");
+DEFINE_FSTR_LOCAL(jsonConfig_str25, "ports");
+DEFINE_FSTR_LOCAL(jsonConfig_str26, "tags");
+DEFINE_FSTR_LOCAL(jsonConfig_str27, "colours");
+DEFINE_FSTR_LOCAL(jsonConfig_str28, "none");
+DEFINE_FSTR_LOCAL(jsonConfig_str29, "empty");
+DEFINE_FSTR_MAP_SORTED(jsonConfig, FSTR::String, FSTR::ObjectBase,
+	{&jsonConfig_str27, &FSTR_DATA_NAME(jsonConfig_map3).object},
+	{&jsonConfig_str20, &FSTR_DATA_NAME(jsonConfig_arr1).object},
+	{&jsonConfig_str29, &FSTR_DATA_NAME(jsonConfig_vec2).object},
+	{&jsonConfig_str18, &FSTR_DATA_NAME(jsonConfig_str0).object},
+	{&jsonConfig_str23, &FSTR_DATA_NAME(jsonConfig_map0).object},
+	{&jsonConfig_str28, nullptr},
+	{&jsonConfig_str25, &FSTR_DATA_NAME(jsonConfig_arr7).object},
+	{&jsonConfig_str21, &FSTR_DATA_NAME(jsonConfig_arr2).object},
+	{&jsonConfig_str22, &FSTR_DATA_NAME(jsonConfig_arr3).object},
+	{&jsonConfig_str24, &FSTR_DATA_NAME(jsonConfig_vec0).object},
+	{&jsonConfig_str26, &FSTR_DATA_NAME(jsonConfig_vec1).object},
+	{&jsonConfig_str19, &FSTR_DATA_NAME(jsonConfig_arr0).object});
@@ -0,0 +1,12 @@
+// Generated by json2fstr.py, do not edit
+
+#pragma once
+
+#include <FlashString/Array.hpp>
+#include <FlashString/SortedMap.hpp>
+#include <FlashString/String.hpp>
+#include <FlashString/Vector.hpp>
+
+using jsonConfig_type0 = FSTR::SortedMap<FSTR::String, FSTR::ObjectBase>;
+
+DECLARE_FSTR_OBJECT(jsonConfig, jsonConfig_type0)
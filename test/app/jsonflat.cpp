@@ -0,0 +1,11 @@
+// Generated by json2fstr.py, do not edit
+
+#include "jsonflat.h"
+
+DEFINE_FSTR_LOCAL(jsonFlat_str0, "x");
+DEFINE_FSTR_LOCAL(jsonFlat_str1, "y");
+DEFINE_FSTR_LOCAL(jsonFlat_str2, "a");
+DEFINE_FSTR_LOCAL(jsonFlat_str3, "b");
+DEFINE_FSTR_MAP_SORTED(jsonFlat, FSTR::String, FSTR::String,
+	{&jsonFlat_str2, &jsonFlat_str0},
+	{&jsonFlat_str3, &jsonFlat_str1});
@@ -0,0 +1,12 @@
+// Generated by json2fstr.py, do not edit
+
+#pragma once
+
+#include <FlashString/Array.hpp>
+#include <FlashString/SortedMap.hpp>
+#include <FlashString/String.hpp>
+#include <FlashString/Vector.hpp>
+
+using jsonFlat_type0 = FSTR::SortedMap<FSTR::String, FSTR::String>;
+
+DECLARE_FSTR_OBJECT(jsonFlat, jsonFlat_type0)
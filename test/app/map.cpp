@@ -22,6 +22,24 @@
 #include <SmingTest.h>
 #include "data.h"
 
+namespace
+{
+DEFINE_FSTR_LOCAL(notFound, "Not Found");
+DEFINE_FSTR_LOCAL(serverError, "Internal Server Error");
+DEFINE_FSTR_MAP_LOCAL(httpErrors, int, FSTR::String, {404, &notFound}, {500, &serverError}, {503, &serverError});
+
+// Everything here is evaluated by the compiler
+static_assert(FSTR_LENGTH(httpErrors) == 3, "FSTR_LENGTH failed");
+static_assert(FSTR_LENGTH(notFound) == 9, "FSTR_LENGTH failed");
+static_assert(FSTR_VALUE_AT(notFound, 4) == 'F', "FSTR_VALUE_AT failed");
+static_assert(FSTR_VALUE_AT(httpErrors, 1).key_ == 500, "FSTR_VALUE_AT failed");
+static_assert(FSTR_INDEX_OF(httpErrors, 503) == 2, "FSTR_INDEX_OF failed");
+static_assert(FSTR_INDEX_OF(httpErrors, 200) < 0, "FSTR_INDEX_OF failed");
+static_assert(FSTR_LOOKUP(httpErrors, 500) == &serverError, "FSTR_LOOKUP failed");
+static_assert(FSTR_LOOKUP(httpErrors, 200) == nullptr, "FSTR_LOOKUP failed");
+
+} // namespace
+
 class MapTest : public TestGroup
 {
 public:
@@ -126,6 +144,101 @@ public:
 				printTableMapEntry("key2");
 			}
 		}
+
+		TEST_CASE("Sorted Map of int => String")
+		{
+			sortedIntMap.printTo(Serial);
+			Serial.println();
+
+			for(unsigned i = 0; i < sortedIntMap.length(); ++i) {
+				auto key = sortedIntMap.valueAt(i).key();
+				REQUIRE(sortedIntMap.indexOf(key) == int(i));
+			}
+			REQUIRE(sortedIntMap[12].content() == "key1");
+			REQUIRE(sortedIntMap.indexOf(-6) == -1);
+			REQUIRE(sortedIntMap.indexOf(1) == -1);
+			REQUIRE(sortedIntMap.indexOf(1001) == -1);
+			REQUIRE(!sortedIntMap[13]);
+		}
+
+		TEST_CASE("Compile-time lookup")
+		{
+			constexpr auto msg = FSTR_LOOKUP(httpErrors, 404);
+			REQUIRE(*msg == notFound);
+			REQUIRE(msg == &httpErrors[404].content());
+			for(unsigned i = 0; i < FSTR_LENGTH(httpErrors); ++i) {
+				auto key = httpErrors.valueAt(i).key();
+				REQUIRE(FSTR_INDEX_OF(httpErrors, key) == httpErrors.indexOf(key));
+			}
+			REQUIRE(FSTR_INDEX_OF(httpErrors, 0) == httpErrors.indexOf(0));
+		}
+
+		TEST_CASE("Sorted Map of String => String")
+		{
+			sortedStringMap.printTo(Serial);
+			Serial.println();
+
+			REQUIRE(sortedStringMap.indexOf("accept") == 0);
+			REQUIRE(sortedStringMap.indexOf("HOST") == 3);
+			REQUIRE(sortedStringMap.indexOf(String("user-agent")) == 4);
+			REQUIRE(sortedStringMap.indexOf("Host", false) == 3);
+			REQUIRE(sortedStringMap.indexOf("host", false) == -1);
+			REQUIRE(sortedStringMap.indexOf("Content-Type", false) == 1);
+			REQUIRE(sortedStringMap.indexOf("content-type", false) == 2);
+			REQUIRE(sortedStringMap.indexOf("CONTENT-TYPE", false) == -1);
+			REQUIRE(sortedStringMap.indexOf("Content") == -1);
+			REQUIRE(sortedStringMap.indexOf("Content-Types") == -1);
+			REQUIRE(sortedStringMap.indexOf("") == -1);
+			REQUIRE(sortedStringMap.indexOf("Zebra") == -1);
+			REQUIRE(sortedStringMap["USER-AGENT"].content() == "key2");
+			REQUIRE(!sortedStringMap["Connection"]);
+		}
+
+		TEST_CASE("Hashed Map of String => String")
+		{
+			hashedMap.printTo(Serial);
+			Serial.println();
+
+			for(unsigned i = 0; i < hashedMap.length(); ++i) {
+				auto& key = hashedMap.valueAt(i).key();
+				REQUIRE(hashedMap.indexOf(key) == int(i));
+				REQUIRE(hashedMap.indexOf(String(key), false) == int(i));
+			}
+			REQUIRE(hashedMap["content-type"].content() == "key1");
+			REQUIRE(hashedMap["IF-NONE-MATCH"].content() == "key2");
+			REQUIRE(hashedMap.indexOf("host", false) == -1);
+			REQUIRE(hashedMap.indexOf("Hosts") == -1);
+			REQUIRE(hashedMap.indexOf("") == -1);
+			REQUIRE(!hashedMap["Referer"]);
+		}
+
+#if FSTR_STATS
+		TEST_CASE("Access statistics")
+		{
+			FSTR::Stats::reset();
+			REQUIRE(FSTR::Stats::find(httpErrors) == nullptr);
+
+			for(unsigned i = 0; i < 10; ++i) {
+				REQUIRE(httpErrors.indexOf(503) == 2);
+			}
+			char buffer[64];
+			REQUIRE(lorem.read(0, buffer, sizeof(buffer)) == sizeof(buffer));
+			REQUIRE(lorem.readFlash(lorem.length() - 10, buffer, sizeof(buffer)) == 10);
+			REQUIRE(lorem.forEachChunk([](const char*, size_t) { return true; }) == lorem.length());
+
+			auto entry = FSTR::Stats::find(httpErrors);
+			REQUIRE(entry != nullptr);
+			REQUIRE((*entry)[FSTR::Stats::Event::lookup].calls == 10);
+			REQUIRE(entry->probes == 10 * 3);
+
+			entry = FSTR::Stats::find(lorem);
+			REQUIRE(entry != nullptr);
+			REQUIRE((*entry)[FSTR::Stats::Event::read].bytes == sizeof(buffer) + lorem.length());
+			REQUIRE((*entry)[FSTR::Stats::Event::readFlash].bytes == 10);
+
+			FSTR::Stats::printReport(Serial, 5);
+		}
+#endif
 	}
 };
 
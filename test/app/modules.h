@@ -3,6 +3,12 @@
 #define TEST_MAP(XX)                                                                                                   \
 	XX(string)                                                                                                         \
 	XX(array)                                                                                                          \
+	XX(table)                                                                                                          \
 	XX(vector)                                                                                                         \
 	XX(map)                                                                                                            \
+	XX(variant)                                                                                                        \
+	XX(json)                                                                                                           \
+	XX(compressed)                                                                                                     \
+	XX(filemap)                                                                                                        \
+	XX(benchmark)                                                                                                      \
 	XX(custom)
@@ -21,6 +21,60 @@
 
 #include <SmingTest.h>
 #include "data.h"
+#include <FlashString/Stream.hpp>
+#include <FlashString/AsyncStream.hpp>
+#include <FlashString/RamCache.hpp>
+#include <FlashString/MultiStream.hpp>
+#include <FlashString/Catalogue.hpp>
+
+/*
+ * Generated from files/template.html using:
+ *
+ * 	python3 ../tools/fstr-template.py --local --prefix COMPONENT_PATH templateHtml files/template.html
+ */
+#include "template.h"
+
+namespace
+{
+// Digest calculated using tools/fstr-digest.py
+IMPORT_FSTR_DIGEST_LOCAL(loremDigest, COMPONENT_PATH "/files/lorem.txt", 0xe59f5f82);
+
+// Deliberately incorrect, so Catalogue::validate() has something to find
+IMPORT_FSTR_DIGEST_LOCAL(loremBadDigest, COMPONENT_PATH "/files/lorem.txt", 0x12345678);
+
+// Imported objects are added to the catalogue automatically
+DEFINE_FSTR_LOCAL(catalogued, "Defined objects must be added");
+FSTR_CATALOGUE_ADD(catalogued)
+
+#define TEMPLATE_OUTPUT                                                                                                \
+	"<html><head><title>Status</title></head>\n"                                                                       \
+	"<body><h1>Status</h1>\n"                                                                                          \
+	"<p>Uptime: 1234 seconds. {not a variable} {}</p>\n"                                                               \
+	"<p>Free heap: </p></body></html>\n"
+
+#define TEMPLATE_OUTPUT_HEAP                                                                                           \
+	"<html><head><title>Status</title></head>\n"                                                                       \
+	"<body><h1>Status</h1>\n"                                                                                          \
+	"<p>Uptime: 1234 seconds. {not a variable} {}</p>\n"                                                               \
+	"<p>Free heap: 1000</p></body></html>\n"
+
+// Read stream using the given buffer size
+String readTemplate(IDataSourceStream& stream, size_t bufSize)
+{
+	char buffer[64];
+	String s;
+	while(!stream.isFinished()) {
+		auto count = stream.readMemoryBlock(buffer, bufSize);
+		if(count == 0) {
+			break;
+		}
+		s.concat(buffer, count);
+		stream.seek(count);
+	}
+	return s;
+}
+
+} // namespace
 
 class StringTest : public TestGroup
 {
@@ -174,6 +228,531 @@ public:
 			REQUIRE(String(demoFSTR1) == demoFSTR2);
 			REQUIRE(demoFSTR1 == String(demoFSTR2));
 		}
+
+		TEST_CASE("Comparison")
+		{
+			// Content spans several compare chunks
+			DEFINE_FSTR_LOCAL(upper, "THIS IS A FLASH STRING -\0SECOND -\0THIRD -\0FOURTH.");
+			DEFINE_FSTR_LOCAL(lastDiffers, "This is a flash string -\0Second -\0Third -\0Fourth!");
+			REQUIRE(demoFSTR1.equals(DEMO_TEST_TEXT, sizeof(DEMO_TEST_TEXT) - 1));
+			REQUIRE(!demoFSTR1.equals(DEMO_TEST_TEXT));
+			REQUIRE(demoFSTR1 != upper);
+			REQUIRE(demoFSTR1.equalsIgnoreCase(upper));
+			REQUIRE(demoFSTR1.equalsIgnoreCase(String(upper)));
+			REQUIRE(!demoFSTR1.equalsIgnoreCase(lastDiffers));
+			REQUIRE(demoFSTR1 != String(lastDiffers));
+			REQUIRE(demoFSTR1.compare(demoFSTR2) == 0);
+			REQUIRE(demoFSTR1.compare(lastDiffers) > 0);
+			REQUIRE(lastDiffers.compare(demoFSTR1) < 0);
+			REQUIRE(demoFSTR1.compare(upper) > 0);
+			REQUIRE(demoFSTR1.compare(upper, true) == 0);
+			REQUIRE(demoFSTR1.compare("This is") > 0);
+			REQUIRE(demoFSTR1.compare("This is b") < 0);
+			REQUIRE(empty.compare("") == 0);
+			REQUIRE(empty.compare(nullptr) == 0);
+			REQUIRE(empty.compare("a") < 0);
+		}
+
+		TEST_CASE("Hashed")
+		{
+			DEFINE_FSTR_HASHED_LOCAL(hashed1, DEMO_TEST_TEXT);
+			DEFINE_FSTR_HASHED_LOCAL(hashed2, "THIS IS A FLASH STRING -\0SECOND -\0THIRD -\0FOURTH.");
+			DEFINE_FSTR_HASHED_LOCAL(hashed3, "This is a flash string -\0Second -\0Third -\0Fourth!");
+			REQUIRE(hashed1.hasHash());
+			REQUIRE(!demoFSTR1.hasHash());
+			REQUIRE(hashed1.length() == demoFSTR1.length());
+			REQUIRE(hashed1.hash() == demoFSTR1.hash());
+			REQUIRE(hashed1.hash() == FSTR::Hash::calculate(DEMO_TEST_TEXT, sizeof(DEMO_TEST_TEXT) - 1));
+			REQUIRE(hashed1.hash() == hashed2.hash());
+			REQUIRE(hashed1.hash() != hashed3.hash());
+			auto copy = hashed1;
+			REQUIRE(copy.isCopy());
+			REQUIRE(copy.hasHash());
+			REQUIRE(copy.hash() == hashed1.hash());
+			REQUIRE(hashed1 == demoFSTR1);
+			REQUIRE(hashed1 == copy);
+			REQUIRE(hashed1 != hashed2);
+			REQUIRE(hashed1.equalsIgnoreCase(hashed2));
+			REQUIRE(hashed1 != hashed3);
+			REQUIRE(!hashed1.equalsIgnoreCase(hashed3));
+			REQUIRE(hashed1 == String(demoFSTR1));
+		}
+
+		TEST_CASE("Digest")
+		{
+			REQUIRE(loremDigest.hasDigest());
+			REQUIRE(loremDigest.digest() == 0xe59f5f82);
+			REQUIRE(loremDigest.length() == lorem.length());
+			REQUIRE(loremDigest == lorem);
+			FSTR::String copy(loremDigest);
+			REQUIRE(copy.hasDigest());
+			REQUIRE(copy.digest() == loremDigest.digest());
+
+			// Calculated when not stored
+			REQUIRE(!lorem.hasDigest());
+			REQUIRE(lorem.digest() == loremDigest.digest());
+			REQUIRE(demoFSTR1.digest() == FSTR::Hash::updateDigest(FSTR::Hash::offsetBasis, DEMO_TEST_TEXT,
+																   sizeof(DEMO_TEST_TEXT) - 1));
+
+			// Stored hash is not a digest
+			DEFINE_FSTR_HASHED_LOCAL(hashed, DEMO_TEST_TEXT);
+			REQUIRE(hashed.hasHash() && !hashed.hasDigest());
+			REQUIRE(hashed.digest() == demoFSTR1.digest());
+			REQUIRE(empty.digest() == FSTR::Hash::offsetBasis);
+		}
+
+		TEST_CASE("Search")
+		{
+			auto& str = externalFSTR1;
+			const char text[] = EXTERNAL_FSTR1_TEXT;
+			auto len = sizeof(text) - 1;
+			// Check all starting positions, so every alignment is covered
+			for(unsigned from = 0; from <= len + 1; ++from) {
+				for(char c : {'T', 's', '\0', 'r', 'x'}) {
+					auto p = (from < len) ? static_cast<const char*>(memchr(&text[from], c, len - from)) : nullptr;
+					int expected = p ? p - text : -1;
+					REQUIRE(str.indexOf(c, from) == expected);
+				}
+			}
+			REQUIRE(str.indexOf("flash") == 20);
+			REQUIRE(str.indexOf("strings") < 0);
+			REQUIRE(str.indexOf("three") == 37);
+			REQUIRE(str.indexOf("t", 34) == 37);
+			REQUIRE(str.indexOf("four") == int(len) - 4);
+			REQUIRE(str.indexOf("fourx") < 0);
+			REQUIRE(str.indexOf("This", 1) < 0);
+			REQUIRE(str.indexOf("") == 0);
+			REQUIRE(str.indexOf("", len) == int(len));
+			REQUIRE(str.indexOf(nullptr) < 0);
+			REQUIRE(str.indexOf(String("external")) == 11);
+			REQUIRE(str.contains('\0'));
+			REQUIRE(str.contains("string"));
+			REQUIRE(!str.contains("String"));
+			REQUIRE(!empty.contains('a'));
+			REQUIRE(!empty.contains("a"));
+
+			REQUIRE(str.startsWith("This is"));
+			REQUIRE(!str.startsWith("this is"));
+			REQUIRE(str.startsWith(""));
+			REQUIRE(str.endsWith("three\0four", 10));
+			REQUIRE(str.endsWith("our"));
+			REQUIRE(!str.endsWith("fou"));
+			REQUIRE(str.endsWith(String("four")));
+			REQUIRE(!str.endsWith(EXTERNAL_FSTR1_TEXT "!"));
+			REQUIRE(demoFSTR1.startsWith(String(demoFSTR1)));
+			REQUIRE(empty.startsWith(""));
+			REQUIRE(!empty.endsWith("a"));
+
+			// Long content
+			REQUIRE(lorem.indexOf(lorem[lorem.length() - 1], lorem.length() - 1) == int(lorem.length()) - 1);
+		}
+
+		TEST_CASE("Pooled")
+		{
+			// pooledVector is defined in another module
+			REQUIRE(&pooledVector[0] == &pooledJson);
+			REQUIRE(&pooledVector[1] == &pooledEscape);
+			REQUIRE(pooledJson.length() == 16);
+			REQUIRE(pooledJson == "application/json");
+			REQUIRE(pooledEscape.length() == sizeof(POOLED_ESCAPE_TEXT) - 1);
+			REQUIRE(pooledEscape == POOLED_ESCAPE_TEXT);
+			REQUIRE(!pooledJson.hasHash());
+			REQUIRE(pooledJson.hash() == FSTR::Hash::calculate("APPLICATION/JSON", 16));
+#if FSTR_TYPE_INFO
+			REQUIRE(pooledJson.type() == FSTR::Type::string);
+			REQUIRE(pooledJson.storedElementSize() == 1);
+#endif
+		}
+
+		TEST_CASE("StringPrinter")
+		{
+			class CountingPrint : public Print
+			{
+			public:
+				size_t write(uint8_t) override
+				{
+					++writes;
+					return 1;
+				}
+
+				size_t write(const uint8_t*, size_t size) override
+				{
+					++writes;
+					return size;
+				}
+
+				unsigned writes = 0;
+			};
+
+			CountingPrint out;
+			REQUIRE(lorem.printTo(out) == lorem.length());
+			REQUIRE(out.writes == (lorem.length() + FSTR_PRINT_CHUNK_SIZE - 1) / FSTR_PRINT_CHUNK_SIZE);
+
+			char buffer[1000];
+			out.writes = 0;
+			REQUIRE(lorem.printer(buffer, sizeof(buffer)).printTo(out) == lorem.length());
+			REQUIRE(out.writes == (lorem.length() + sizeof(buffer) - 1) / sizeof(buffer));
+
+			auto printer = lorem.printer(buffer, 16);
+			printer.setCacheThreshold(0);
+			out.writes = 0;
+			REQUIRE(printer.printTo(out) == lorem.length());
+			REQUIRE(out.writes == (lorem.length() + 15) / 16);
+		}
+
+		TEST_CASE("Stream pointer")
+		{
+			FSTR::Stream fs(demoFSTR1, false);
+			REQUIRE(fs.getStreamPointer() == reinterpret_cast<const char*>(demoFSTR1.data()));
+			fs.seek(10);
+			REQUIRE(fs.getStreamPointer() == reinterpret_cast<const char*>(demoFSTR1.data()) + 10);
+			REQUIRE(size_t(fs.available()) == demoFSTR1.length() - 10);
+
+			FSTR::Stream flashStream(demoFSTR1);
+			REQUIRE(flashStream.getStreamPointer() == nullptr);
+
+			// Positional reads don't affect stream position
+			char buf[8];
+			REQUIRE(flashStream.pread(5, buf, sizeof(buf)) == sizeof(buf));
+			REQUIRE(memcmp(buf, DEMO_TEST_TEXT + 5, sizeof(buf)) == 0);
+			REQUIRE(fs.pread(demoFSTR1.length() - 2, buf, sizeof(buf)) == 2);
+			REQUIRE(size_t(fs.available()) == demoFSTR1.length() - 10);
+			REQUIRE(size_t(flashStream.available()) == demoFSTR1.length());
+		}
+
+		TEST_CASE("AsyncStream")
+		{
+			using FSTR::AsyncStream;
+
+			AsyncStream stream1(lorem);
+			AsyncStream stream2(lorem);
+			REQUIRE(stream1.available() == int(lorem.length()));
+			REQUIRE(!stream1.isReady());
+			// Streams are serviced in turn
+			REQUIRE(AsyncStream::service());
+			REQUIRE(stream1.isReady());
+			REQUIRE(!stream2.isReady());
+			REQUIRE(AsyncStream::service());
+			REQUIRE(stream2.isReady());
+
+			while(!stream1.isFinished() || !stream2.isFinished()) {
+				if(!stream1.isFinished()) {
+					readChunk(stream1, lorem);
+				}
+				AsyncStream::service();
+				if(!stream2.isFinished()) {
+					REQUIRE(stream2.isReady());
+					readChunk(stream2, lorem);
+				}
+				AsyncStream::service();
+			}
+			REQUIRE(stream1.available() == 0);
+			REQUIRE(!AsyncStream::service());
+
+			// Data not yet prefetched is read immediately
+			AsyncStream stream3(externalFSTR1);
+			REQUIRE(!stream3.isReady());
+			readChunk(stream3, externalFSTR1);
+			REQUIRE(stream3.isFinished());
+			REQUIRE(!AsyncStream::service());
+
+			// Seeking
+			AsyncStream stream4(lorem);
+			REQUIRE(stream4.seekFrom(-10, SeekOrigin::End) == int(lorem.length()) - 10);
+			readChunk(stream4, lorem);
+			REQUIRE(stream4.isFinished());
+			REQUIRE(stream4.seekFrom(AsyncStream::blockSize - 5, SeekOrigin::Start) == AsyncStream::blockSize - 5);
+			readChunk(stream4, lorem);
+			REQUIRE(stream4.seekFrom(1, SeekOrigin::End) < 0);
+		}
+
+		TEST_CASE("IndexedTemplateStream")
+		{
+			REQUIRE(templateHtml_vars.length() == 3);
+
+			for(size_t bufSize : {1, 7, 64}) {
+				FSTR::IndexedTemplateStream stream(templateHtml, templateHtml_segments, templateHtml_vars);
+				REQUIRE(stream.variableCount() == 3);
+				REQUIRE(stream.setVar("title", F("Status")));
+				REQUIRE(stream.setVar("uptime", F("1234")));
+				REQUIRE(!stream.setVar("missing", F("none")));
+				REQUIRE(readTemplate(stream, bufSize) == F(TEMPLATE_OUTPUT));
+
+				// Restart, with a variable value changed
+				REQUIRE(stream.seekFrom(0, SeekOrigin::Start) == 0);
+				stream.setVar(2, F("1000"));
+				REQUIRE(readTemplate(stream, bufSize) == F(TEMPLATE_OUTPUT_HEAP));
+			}
+
+			// Literal text is accessible directly
+			FSTR::IndexedTemplateStream stream(templateHtml, templateHtml_segments, templateHtml_vars);
+			size_t length;
+			auto ptr = stream.getStreamPointer(length);
+			REQUIRE(ptr != nullptr);
+			REQUIRE(length == 19);
+			REQUIRE(ptr == reinterpret_cast<const char*>(templateHtml.data()));
+			// Value for 'title' is empty so we move straight to the next segment
+			REQUIRE(stream.seek(length));
+			ptr = stream.getStreamPointer(length);
+			REQUIRE(ptr == reinterpret_cast<const char*>(templateHtml.data()) + 26);
+			REQUIRE(stream.seekFrom(-1, SeekOrigin::Current) < 0);
+		}
+
+		TEST_CASE("Slice")
+		{
+			// EXTERNAL_FSTR1_TEXT "This is an external flash string\0two\0three\0four"
+			auto slice = externalFSTR1.slice(8, 11);
+			REQUIRE(&slice.object() == &externalFSTR1);
+			REQUIRE(slice.offset() == 8);
+			REQUIRE(slice.length() == 11);
+			REQUIRE(slice == "an external");
+			REQUIRE(slice != "an externa");
+			REQUIRE(slice.equals("an external\0", 11));
+
+			char buffer[16]{};
+			REQUIRE(slice.read(3, buffer, sizeof(buffer)) == 8);
+			REQUIRE(memcmp(buffer, "external", 8) == 0);
+			REQUIRE(slice.readFlash(11, buffer, sizeof(buffer)) == 0);
+
+			// Out of range values are truncated
+			REQUIRE(externalFSTR1.slice(1000).length() == 0);
+			REQUIRE(externalFSTR1.slice(33).length() == externalFSTR1.length() - 33);
+			REQUIRE(slice.slice(3, 1000) == "external");
+			REQUIRE(slice.slice(3, 1000).offset() == 11);
+
+			// Slices of copies refer to the original
+			auto copy = externalFSTR1;
+			REQUIRE(&copy.slice(0).object() == &externalFSTR1);
+
+			DEFINE_FSTR_LOCAL(other, "Is an external flash");
+			REQUIRE(other.slice(3, 11) == slice);
+			REQUIRE(other.slice(3, 10) != slice);
+			REQUIRE(other.slice(0, 11) != slice);
+
+			Serial.print("> slice: ");
+			REQUIRE(slice.printTo(Serial) == 11);
+			Serial.println();
+
+			FSTR::Stream stream(slice);
+			REQUIRE(stream.available() == 11);
+			REQUIRE(stream.seekFrom(3, SeekOrigin::Start) == 3);
+			REQUIRE(stream.readMemoryBlock(buffer, sizeof(buffer)) == 8);
+			REQUIRE(memcmp(buffer, "external", 8) == 0);
+			REQUIRE(stream.seekFrom(0, SeekOrigin::End) == 11);
+			REQUIRE(stream.isFinished());
+			REQUIRE(stream.seekFrom(1, SeekOrigin::End) < 0);
+
+			FSTR::Stream cached(slice, false);
+			REQUIRE(cached.getStreamPointer() == reinterpret_cast<const char*>(externalFSTR1.data()) + 8);
+		}
+
+		TEST_CASE("MultiStream")
+		{
+			DEFINE_FSTR_LOCAL(header, "<header>");
+			DEFINE_FSTR_LOCAL(footer, "<footer>");
+			String dynamic = F("[dynamic]");
+
+			FSTR::MultiStream stream;
+			REQUIRE(stream.add(header));
+			REQUIRE(stream.add(dynamic.c_str(), dynamic.length()));
+			REQUIRE(stream.add(externalFSTR1, 8, 11));
+			REQUIRE(stream.add(FSTR::String::empty()));
+			REQUIRE(stream.add(externalFSTR1, 1000));
+			REQUIRE(stream.add(footer, 1));
+			REQUIRE(stream.count() == 6);
+
+			DEFINE_FSTR_LOCAL(expected, "<header>[dynamic]an externalfooter>");
+			REQUIRE(stream.length() == expected.length());
+			REQUIRE(size_t(stream.available()) == expected.length());
+
+			char buffer[64];
+			for(size_t bufSize : {1, 4, 7, 64}) {
+				REQUIRE(stream.seekFrom(0, SeekOrigin::Start) == 0);
+				String s;
+				while(!stream.isFinished()) {
+					auto count = stream.readMemoryBlock(buffer, bufSize);
+					REQUIRE(count != 0);
+					s.concat(buffer, count);
+					stream.seek(count);
+				}
+				REQUIRE(expected == s);
+			}
+
+			// Seek backwards across parts
+			REQUIRE(stream.seekFrom(-16, SeekOrigin::End) == int(expected.length() - 16));
+			REQUIRE(stream.readMemoryBlock(buffer, sizeof(buffer)) == 16);
+			REQUIRE(memcmp(buffer, " externalfooter>", 16) == 0);
+			REQUIRE(stream.seekFrom(1, SeekOrigin::End) < 0);
+
+			stream.clear();
+			REQUIRE(stream.isFinished());
+			for(unsigned i = 0; i < FSTR::MultiStream::maxParts; ++i) {
+				REQUIRE(stream.add(header));
+			}
+			REQUIRE(!stream.add(footer));
+		}
+
+		TEST_CASE("RamCache")
+		{
+			DEFINE_FSTR_LOCAL(one, "one");
+			DEFINE_FSTR_LOCAL(two, "two");
+			DEFINE_FSTR_LOCAL(six, "six");
+
+			// Find size of one entry
+			size_t entrySize;
+			{
+				FSTR::RamCache cache(1024);
+				REQUIRE(cache.add(one));
+				entrySize = cache.used();
+			}
+
+			// Room for two entries
+			FSTR::RamCache cache(entrySize * 2, 64);
+			REQUIRE(cache.get(lorem) == nullptr);
+			REQUIRE(cache.misses() == 1);
+			REQUIRE(cache.count() == 0);
+
+			auto data = cache.get(one);
+			REQUIRE(data != nullptr);
+			REQUIRE(memcmp(data, "one", 3) == 0);
+			REQUIRE(cache.get(one) == data);
+			REQUIRE(cache.hits() == 1);
+			// Copies share the same entry
+			FSTR::String copy(one);
+			REQUIRE(cache.find(copy) == data);
+
+			REQUIRE(cache.get(two) != nullptr);
+			REQUIRE(cache.used() == entrySize * 2);
+			// Use 'one' so 'two' is evicted
+			REQUIRE(cache.get(one) == data);
+			REQUIRE(cache.get(six) != nullptr);
+			REQUIRE(cache.count() == 2);
+			REQUIRE(cache.find(two) == nullptr);
+			REQUIRE(cache.find(one) == data);
+
+			char buf[8];
+			REQUIRE(cache.read(six, 1, buf, sizeof(buf)) == 2);
+			REQUIRE(memcmp(buf, "ix", 2) == 0);
+			REQUIRE(cache.read(lorem, 0, buf, sizeof(buf)) == sizeof(buf));
+
+			// Too big for the budget
+			REQUIRE(!cache.add(lorem));
+			REQUIRE(cache.remove(one));
+			REQUIRE(!cache.remove(one));
+			REQUIRE(cache.count() == 1);
+			cache.clear();
+			REQUIRE(cache.used() == 0);
+
+#if FSTR_RAM_CACHE
+			// Redirect all reads
+			FSTR::RamCache::setActive(&cache);
+			auto hits = cache.hits();
+			auto misses = cache.misses();
+			// Objects are not loaded on demand
+			REQUIRE(two.read(0, buf, 3) == 3);
+			REQUIRE(cache.find(two) == nullptr);
+			REQUIRE(cache.add(two));
+			REQUIRE(two.readFlash(0, buf, 3) == 3);
+			REQUIRE(cache.hits() == hits + 1);
+			REQUIRE(memcmp(buf, "two", 3) == 0);
+			// Comparisons use the RAM copy
+			REQUIRE(two == "two");
+			REQUIRE(two.equalsIgnoreCase("TWO"));
+			REQUIRE(two.compare("twp") < 0);
+			REQUIRE(cache.hits() == hits + 4);
+			REQUIRE(cache.misses() == misses);
+			FSTR::RamCache::setActive(nullptr);
+
+			// Map lookups use a loaded key table
+			FSTR::RamCache mapCache(1024);
+			FSTR::RamCache::setActive(&mapCache);
+			REQUIRE(mapCache.add(enumMap));
+			REQUIRE(mapCache.add(stringMap));
+			REQUIRE(enumMap[KeyB]);
+			REQUIRE(mapCache.hits() == 1);
+			REQUIRE(stringMap["key2"]);
+			REQUIRE(mapCache.hits() == 2);
+			REQUIRE(!stringMap["key3"]);
+			REQUIRE(mapCache.misses() == 0);
+			FSTR::RamCache::setActive(nullptr);
+#endif
+		}
+
+		TEST_CASE("Catalogue")
+		{
+			using FSTR::Catalogue::Error;
+			using FSTR::Catalogue::check;
+
+			REQUIRE(check(lorem) == Error::none);
+			REQUIRE(check(loremDigest, true) == Error::none);
+			REQUIRE(check(FSTR::String(lorem)) != Error::none);
+
+			uint32_t buffer[4]{};
+			REQUIRE(check(*reinterpret_cast<const FSTR::ObjectBase*>(uintptr_t(buffer) + 1)) == Error::alignment);
+
+			REQUIRE(check(loremBadDigest) == Error::none);
+			REQUIRE(check(loremBadDigest, true) == Error::digest);
+			REQUIRE(strcmp(FSTR::Catalogue::toString(Error::digest), "digest") == 0);
+
+#if FSTR_CATALOGUE
+			auto count = FSTR::Catalogue::count();
+			REQUIRE(count != 0);
+			REQUIRE(FSTR::Catalogue::entryAt(count) == nullptr);
+			unsigned found = 0;
+			for(unsigned i = 0; i < count; ++i) {
+				auto entry = FSTR::Catalogue::entryAt(i);
+				if(entry == &loremDigest || entry == &catalogued) {
+					++found;
+				}
+			}
+			REQUIRE(found == 2);
+
+			// Digests are only checked on request
+			auto report = FSTR::Catalogue::validate();
+			REQUIRE(report);
+			REQUIRE(report.objects == count);
+			REQUIRE(report.firstFailure == nullptr);
+			REQUIRE(report.bytes >= loremDigest.length() + loremBadDigest.length());
+			report.printTo(Serial);
+			Serial.println();
+
+			static unsigned failures;
+			static const FSTR::ObjectBase* failedObject;
+			static Error failedError;
+			failures = 0;
+			report = FSTR::Catalogue::validate(true, [](const FSTR::ObjectBase& object, Error error) {
+				failedObject = &object;
+				failedError = error;
+				++failures;
+			});
+			REQUIRE(!report);
+			REQUIRE(report.failures == 1);
+			REQUIRE(failures == 1);
+			REQUIRE(failedObject == &loremBadDigest);
+			REQUIRE(failedError == Error::digest);
+			REQUIRE(report.firstFailure == &loremBadDigest);
+			REQUIRE(report.firstError == Error::digest);
+			report.printTo(Serial);
+			Serial.println();
+#else
+			REQUIRE(FSTR::Catalogue::count() == 0);
+			REQUIRE(FSTR::Catalogue::validate());
+#endif
+		}
+	}
+
+private:
+	// Read in chunks which don't line up with AsyncStream prefetch blocks
+	void readChunk(FSTR::AsyncStream& stream, const FSTR::String& str)
+	{
+		char buf[300];
+		char ref[sizeof(buf)];
+		auto pos = str.length() - stream.available();
+		auto n = stream.readMemoryBlock(buf, sizeof(buf));
+		REQUIRE(n != 0);
+		REQUIRE(str.read(pos, ref, n) == n);
+		REQUIRE(memcmp(buf, ref, n) == 0);
+		stream.seek(n);
 	}
 };
 
@@ -0,0 +1,106 @@
+/**
+ * table.cpp
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#include <SmingTest.h>
+#include <FlashString/Table.hpp>
+
+namespace
+{
+// 3 columns, 4 rows, given column by column
+DEFINE_FSTR_TABLE_LOCAL(floatTable, float, 3, 1, 4, 7, 10, 2, 5, 8, 11, 3, 6, 9, 12);
+
+// Dense table spanning several read blocks
+#define INT_COLUMN(n)                                                                                                  \
+	n + 0, n + 1, n + 2, n + 3, n + 4, n + 5, n + 6, n + 7, n + 8, n + 9, n + 10, n + 11, n + 12, n + 13, n + 14,      \
+		n + 15, n + 16, n + 17, n + 18, n + 19
+DEFINE_FSTR_TABLE_LOCAL(intTable, uint16_t, 2, INT_COLUMN(100), INT_COLUMN(200));
+
+} // namespace
+
+class TableTest : public TestGroup
+{
+public:
+	TableTest() : TestGroup(_F("Table"))
+	{
+	}
+
+	void execute() override
+	{
+		TEST_CASE("Cell access")
+		{
+			REQUIRE(floatTable.rows() == 4);
+			REQUIRE(floatTable.columns() == 3);
+			REQUIRE(floatTable.length() == 12);
+			REQUIRE(floatTable(0, 0) == 1);
+			REQUIRE(floatTable(1, 2) == 6);
+			REQUIRE(floatTable(3, 1) == 11);
+			REQUIRE(floatTable.cell(3, 2) == 12);
+			// Out of range
+			REQUIRE(floatTable(4, 0) == 0);
+			REQUIRE(floatTable(0, 3) == 0);
+		}
+
+		TEST_CASE("Column access")
+		{
+			auto col = floatTable.column(1);
+			REQUIRE(col != nullptr);
+			REQUIRE(FSTR::readValue(&col[2]) == 8);
+			REQUIRE(floatTable.column(3) == nullptr);
+
+			uint16_t values[32];
+			REQUIRE(intTable.readColumn(1, 5, values, 10) == 10);
+			for(unsigned i = 0; i < 10; ++i) {
+				REQUIRE(values[i] == 205 + i);
+			}
+			// Truncated at end of column
+			REQUIRE(intTable.readColumn(0, 15, values, 10) == 5);
+			REQUIRE(values[4] == 119);
+			REQUIRE(intTable.readColumn(2, 0, values, 10) == 0);
+			REQUIRE(intTable.readColumn(0, 20, values, 10) == 0);
+		}
+
+		TEST_CASE("Row access")
+		{
+			auto row = floatTable.row(2);
+			REQUIRE(row.length() == 3);
+			REQUIRE(row[0] == 7);
+			REQUIRE(row[1] == 8);
+			REQUIRE(row[2] == 9);
+			row = floatTable.row(4);
+			REQUIRE(row[0] == 0);
+
+			FSTR::Table<uint16_t, 2>::Row rows[32];
+			REQUIRE(intTable.readRows(0, rows, 32) == 20);
+			for(unsigned i = 0; i < 20; ++i) {
+				REQUIRE(rows[i][0] == 100 + i);
+				REQUIRE(rows[i][1] == 200 + i);
+			}
+			REQUIRE(intTable.readRows(18, rows, 32) == 2);
+			REQUIRE(rows[1][1] == 219);
+			REQUIRE(intTable.readRows(20, rows, 32) == 0);
+
+			REQUIRE(FSTR::print(Serial, floatTable) > 0);
+		}
+	}
+};
+
+void REGISTER_TEST(table)
+{
+	registerGroup<TableTest>();
+}
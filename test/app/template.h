@@ -0,0 +1,15 @@
+// Generated by fstr-template.py, do not edit
+
+#include <FlashString/IndexedTemplateStream.hpp>
+
+IMPORT_FSTR_LOCAL(templateHtml, COMPONENT_PATH "/files/template.html");
+DEFINE_FSTR_LOCAL(templateHtml_var0, "title");
+DEFINE_FSTR_LOCAL(templateHtml_var1, "uptime");
+DEFINE_FSTR_LOCAL(templateHtml_var2, "heap");
+DEFINE_FSTR_VECTOR_LOCAL(templateHtml_vars, FSTR::String, &templateHtml_var0, &templateHtml_var1, &templateHtml_var2);
+DEFINE_FSTR_ARRAY_LOCAL(templateHtml_segments, FSTR::TemplateSegment,
+	{0, 19, 0x0000},
+	{26, 26, 0x0000},
+	{59, 17, 0x0001},
+	{84, 48, 0x0002},
+	{138, 19, 0xffff});
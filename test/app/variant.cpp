@@ -0,0 +1,196 @@
+/**
+ * variant.cpp
+ *
+ * Copyright 2019 mikee47 <mike@sillyhouse.net>
+ *
+ * This file is part of the FlashString Library
+ *
+ * This library is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, version 3 or later.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this library.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ ****/
+
+#include <SmingTest.h>
+#include "data.h"
+#include <FlashString/Variant.hpp>
+
+namespace
+{
+class CapturePrint : public Print
+{
+public:
+	size_t write(uint8_t c) override
+	{
+		return write(&c, 1);
+	}
+
+	size_t write(const uint8_t* data, size_t size) override
+	{
+		size = std::min(size, sizeof(buffer) - 1 - length);
+		memcpy(&buffer[length], data, size);
+		length += size;
+		buffer[length] = '\0';
+		return size;
+	}
+
+	char buffer[512];
+	size_t length = 0;
+};
+
+// Variant output should match that of the typed object
+template <class ObjectType> bool printMatches(const ObjectType& object)
+{
+	CapturePrint typed;
+	CapturePrint variant;
+	object.printTo(typed);
+	FSTR::Variant(object).printTo(variant);
+	return strcmp(typed.buffer, variant.buffer) == 0;
+}
+
+} // namespace
+
+class VariantTest : public TestGroup
+{
+public:
+	VariantTest() : TestGroup(_F("Variant"))
+	{
+	}
+
+	void execute() override
+	{
+#if FSTR_TYPE_INFO
+		TEST_CASE("Type information")
+		{
+			REQUIRE(externalFSTR1.type() == FSTR::Type::string);
+			REQUIRE(externalFSTR1.length() == sizeof(EXTERNAL_FSTR1_TEXT) - 1);
+			REQUIRE(doubleArray.type() == FSTR::Type::floatingPoint);
+			REQUIRE(doubleArray.storedElementSize() == sizeof(double));
+			REQUIRE(int64Array.type() == FSTR::Type::signedInt);
+			REQUIRE(stringVector.type() == FSTR::Type::vector);
+			REQUIRE(enumMap.type() == FSTR::Type::unsignedMap);
+			REQUIRE(enumMap.storedElementSize() == 1);
+			REQUIRE(arrayMap.type() == FSTR::Type::signedMap);
+			REQUIRE(vectorMap.type() == FSTR::Type::stringMap);
+			REQUIRE(hashedMap.type() == FSTR::Type::stringMap);
+			// Stored with a hash
+			REQUIRE(hashedVector[0].type() == FSTR::Type::string);
+			REQUIRE(hashedVector[0].hasHash());
+			// Rows are too large for type information
+			REQUIRE(tableArray.type() == FSTR::Type::none);
+			// Imported objects have no type information
+			REQUIRE(lorem.type() == FSTR::Type::none);
+
+			// Copies refer to the original object
+			FSTR::String copy(externalFSTR1);
+			REQUIRE(copy.isCopy());
+			REQUIRE(copy.type() == FSTR::Type::string);
+			REQUIRE(copy.length() == externalFSTR1.length());
+		}
+
+		TEST_CASE("Array")
+		{
+			FSTR::Variant v(doubleArray);
+			REQUIRE(v.isArray());
+			REQUIRE(v.length() == doubleArray.length());
+			REQUIRE(v.getFloat(0) == doubleArray[0]);
+			REQUIRE(v.getInt(3) == 100000000);
+			REQUIRE(v.getFloat(5) == 0);
+			REQUIRE(!v.valueAt(0));
+
+			FSTR::Variant v64(int64Array);
+			REQUIRE(v64.length() == 5);
+			REQUIRE(v64.getInt(4) == 5);
+			REQUIRE(printMatches(doubleArray));
+		}
+
+		TEST_CASE("String")
+		{
+			FSTR::Variant v(externalFSTR1);
+			REQUIRE(v.isString());
+			REQUIRE(v.asString() == externalFSTR1);
+			REQUIRE(v.length() == externalFSTR1.length());
+			REQUIRE(FSTR::Variant(doubleArray).asString().length() == 0);
+			REQUIRE(printMatches(externalFSTR1));
+		}
+
+		TEST_CASE("Vector")
+		{
+			FSTR::Variant v(stringVector);
+			REQUIRE(v.isVector());
+			REQUIRE(v.length() == 3);
+			REQUIRE(v[0].asString() == stringVector[0]);
+			REQUIRE(!v[1]);
+			REQUIRE(!v[3]);
+			REQUIRE(printMatches(stringVector));
+		}
+
+		TEST_CASE("Map")
+		{
+			FSTR::Variant v(vectorMap);
+			REQUIRE(v.isMap());
+			REQUIRE(v.length() == 1);
+			REQUIRE(v.keyAt(0).asString() == "key1");
+			REQUIRE(v.indexOf("KEY1") == 0);
+			REQUIRE(v.indexOf("key1", false) == 0);
+			REQUIRE(v.indexOf("KEY1", false) < 0);
+			auto vec = v.find("key1");
+			REQUIRE(vec.isVector());
+			REQUIRE(vec[2].asString() == stringVector[2]);
+			REQUIRE(!v.find("key2"));
+			REQUIRE(printMatches(vectorMap));
+
+			FSTR::Variant ints(arrayMap);
+			REQUIRE(ints.length() == 2);
+			REQUIRE(ints.getInt(1) == 2);
+			REQUIRE(ints.indexOf(2) == 1);
+			REQUIRE(ints[1].getFloat(6) == 10);
+			REQUIRE(!ints.keyAt(0));
+			REQUIRE(printMatches(arrayMap));
+
+			FSTR::Variant enums(enumMap);
+			REQUIRE(enums.indexOf(KeyB) == 1);
+			REQUIRE(enums.indexOf(KeyC) < 0);
+			REQUIRE(printMatches(enumMap));
+
+			FSTR::Variant hashed(hashedMap);
+			REQUIRE(hashed.length() == hashedMap.length());
+			REQUIRE(hashed.find("content-type").asString() == "key1");
+		}
+#else
+		TEST_CASE("No type information")
+		{
+			REQUIRE(externalFSTR1.type() == FSTR::Type::none);
+			REQUIRE(doubleArray.storedElementSize() == 0);
+			FSTR::Variant v(doubleArray);
+			REQUIRE(v.length() == doubleArray.length() * sizeof(double));
+			Serial.println(_F("FSTR_TYPE_INFO disabled, skipping Variant tests"));
+		}
+#endif
+
+		TEST_CASE("Untyped")
+		{
+			FSTR::Variant v(lorem);
+			REQUIRE(v.type() == FSTR::Type::none);
+			REQUIRE(v.length() == lorem.length());
+			REQUIRE(v.elementSize() == 1);
+			REQUIRE(!v.isString());
+
+			FSTR::Variant null;
+			REQUIRE(!null);
+			REQUIRE(null.length() == 0);
+			REQUIRE(!null[0]);
+		}
+	}
+};
+
+void REGISTER_TEST(variant)
+{
+	registerGroup<VariantTest>();
+}
@@ -22,6 +22,13 @@
 #include <SmingTest.h>
 #include "data.h"
 
+/*
+ * Generated from files/commands.txt using:
+ *
+ * 	python3 ../tools/fstr-prefix.py --local commands files/commands.txt
+ */
+#include "commands.h"
+
 class VectorTest : public TestGroup
 {
 public:
@@ -78,6 +85,63 @@ public:
 				REQUIRE(i == 1);
 			}
 		}
+
+		TEST_CASE("Vector<String> with hashes")
+		{
+			REQUIRE(hashedVector.indexOf("GET") == 0);
+			REQUIRE(hashedVector.indexOf("head") == 3);
+			REQUIRE(hashedVector.indexOf("head", false) == -1);
+			REQUIRE(hashedVector.indexOf(String("POST"), false) == 2);
+			REQUIRE(hashedVector.indexOf(hashedVector[1]) == 1);
+			REQUIRE(hashedVector.indexOf("PATCH") == -1);
+			REQUIRE(hashedVector.indexOf("") == -1);
+		}
+
+		TEST_CASE("PrefixVector")
+		{
+			REQUIRE(commands.length() == 17);
+
+			// Matches are in sort order, ignoring case
+			auto match = commands.startsWith("WiFi");
+			REQUIRE(match.length() == 3);
+			REQUIRE(match[0] == "wifi");
+			REQUIRE(match[1] == "WIFI-connect");
+			REQUIRE(match[2] == "wifi-scan");
+			REQUIRE(match.indexAt(3) < 0);
+			unsigned count = 0;
+			for(auto& cmd : match) {
+				REQUIRE(cmd.length() >= 4);
+				++count;
+			}
+			REQUIRE(count == 3);
+
+			REQUIRE(commands.startsWith("s").length() == 6);
+			REQUIRE(commands.startsWith("se").length() == 2);
+			REQUIRE(commands.startsWith("res").length() == 2);
+			REQUIRE(commands.startsWith("x").length() == 0);
+			REQUIRE(commands.startsWith("helping").length() == 0);
+			REQUIRE(commands.startsWith("").length() == commands.length());
+			REQUIRE(commands.startsWith(String("/api")).length() == 3);
+
+			REQUIRE(commands.findPrefix("sh") == 12);
+			REQUIRE(commands.findPrefix("show-") == 11);
+			REQUIRE(commands.findPrefix("EX") == 16);
+			REQUIRE(commands.findPrefix("z") < 0);
+
+			REQUIRE(commands.longestMatch("/api/v1/config/wifi") == 4);
+			REQUIRE(commands.longestMatch("/api/v1/status") == 3);
+			REQUIRE(commands.longestMatch("/api/v2") == 2);
+			REQUIRE(commands.longestMatch("/index.html") == 5);
+			REQUIRE(commands.longestMatch("SETUP wifi") == 7);
+			REQUIRE(commands.longestMatch("shower") == 10);
+			REQUIRE(commands.longestMatch("shell") == 12);
+			REQUIRE(commands.longestMatch("se") < 0);
+			REQUIRE(commands.longestMatch("") < 0);
+
+			// Regular Vector methods are unaffected
+			REQUIRE(commands.indexOf("SET") == 6);
+			REQUIRE(commands[1] == "status");
+		}
 	}
 };
 
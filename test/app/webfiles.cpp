@@ -0,0 +1,18 @@
+// Generated by filemap.py, do not edit
+
+#include <FlashString/FileMap.hpp>
+
+DEFINE_FSTR_LOCAL(webFiles_mime0, "text/html");
+IMPORT_FSTR_COMPRESSED_LOCAL(webFiles_file0, COMPONENT_PATH "/files/www.fstr/index.html.lzss");
+DEFINE_FSTR_LOCAL(webFiles_path0, "index.html");
+DEFINE_FSTR_LOCAL(webFiles_mime1, "application/json");
+IMPORT_FSTR_LOCAL(webFiles_file1, COMPONENT_PATH "/files/www/info.json");
+DEFINE_FSTR_LOCAL(webFiles_path1, "info.json");
+DEFINE_FSTR_LOCAL(webFiles_mime2, "text/css");
+IMPORT_FSTR_LOCAL(webFiles_file2, COMPONENT_PATH "/files/www/css/style.css");
+DEFINE_FSTR_LOCAL(webFiles_path2, "css/style.css");
+DEFINE_FSTR_ARRAY_LOCAL(webFiles_index, int16_t, -2, 0);
+DEFINE_FSTR_FILEMAP(webFiles, 0, &webFiles_index,
+	{&webFiles_path1, &FSTR_DATA_NAME(webFiles_file1), &webFiles_mime1, 36, 0x9fe5ae2d, FSTR::Compression::none},
+	{&webFiles_path2, &FSTR_DATA_NAME(webFiles_file2), &webFiles_mime2, 54, 0x9dfaac3d, FSTR::Compression::none},
+	{&webFiles_path0, &FSTR_DATA_NAME(webFiles_file0), &webFiles_mime0, 634, 0x6fb14db6, FSTR::Compression::lzss});
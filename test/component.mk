@@ -7,6 +7,15 @@ COMPONENT_DEPENDS := \
 # Don't need network
 HOST_NETWORK_OPTIONS := --nonet
 
+# Enable type information so Variant can be tested
+FSTR_TYPE_INFO ?= 1
+
+# Set to 1 to test access statistics (affects benchmark timings)
+FSTR_STATS ?= 0
+
+# Set to 1 to test catalogue validation with all imported objects
+FSTR_CATALOGUE ?= 0
+
 # Time in milliseconds to pause after a test group has completed
 CONFIG_VARS += TEST_GROUP_INTERVAL
 TEST_GROUP_INTERVAL ?= 100
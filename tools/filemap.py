@@ -0,0 +1,177 @@
+#!/usr/bin/env python3
+#
+# filemap.py - Generate a FlashString FileMap definition from a directory
+#
+# Copyright 2019 mikee47 <mike@sillyhouse.net>
+#
+# This file is part of the FlashString Library
+#
+# This library is free software: you can redistribute it and/or modify it under the terms of the
+# GNU General Public License as published by the Free Software Foundation, version 3 or later.
+#
+# This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+# without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+# See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this library.
+# If not, see <https://www.gnu.org/licenses/>.
+#
+# All files in the directory are imported, with paths relative to it. Text files may be compressed
+# using the same formats as fstr-compress.py; the compressed files are written to --output-dir.
+#
+# Output is written to stdout, suitable for inclusion in a source file.
+# Imported file names are relative to the current directory, or use --prefix to give
+# a base directory, e.g. `--prefix COMPONENT_PATH`. Absolute paths are used as given.
+#
+
+import argparse
+import gzip
+import importlib.util
+import mimetypes
+import os
+import struct
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import maphash
+
+_spec = importlib.util.spec_from_file_location(
+    'fstr_compress', os.path.join(os.path.dirname(os.path.abspath(__file__)), 'fstr-compress.py'))
+fstr_compress = importlib.util.module_from_spec(_spec)
+_spec.loader.exec_module(fstr_compress)
+
+# ETag values must match FSTR::ObjectBase::digest()
+_spec = importlib.util.spec_from_file_location(
+    'fstr_digest', os.path.join(os.path.dirname(os.path.abspath(__file__)), 'fstr-digest.py'))
+fstr_digest = importlib.util.module_from_spec(_spec)
+_spec.loader.exec_module(fstr_digest)
+
+# Common web types, so output doesn't depend on the host's MIME database
+MIME_TYPES = {
+    '.htm': 'text/html',
+    '.html': 'text/html',
+    '.css': 'text/css',
+    '.js': 'application/javascript',
+    '.json': 'application/json',
+    '.txt': 'text/plain',
+    '.xml': 'text/xml',
+    '.svg': 'image/svg+xml',
+    '.png': 'image/png',
+    '.jpg': 'image/jpeg',
+    '.jpeg': 'image/jpeg',
+    '.gif': 'image/gif',
+    '.ico': 'image/x-icon',
+}
+
+COMPRESSIBLE_TYPES = ['text/', 'application/javascript', 'application/json', 'image/svg+xml']
+
+COMPRESSION = {
+    'none': 'FSTR::Compression::none',
+    'lzss': 'FSTR::Compression::lzss',
+    'gzip': 'FSTR::Compression::gzip',
+}
+
+
+def mime_type(path):
+    ext = os.path.splitext(path)[1].lower()
+    mime = MIME_TYPES.get(ext) or mimetypes.guess_type(path)[0]
+    return mime or 'application/octet-stream'
+
+
+def compress(data, method, window_bits):
+    """Returns (content, size) where size is the number of bytes the stream produces"""
+    if method == 'lzss':
+        content = fstr_compress.lzss_compress(data, window_bits)
+        header = struct.pack('<IBBH', len(data), fstr_compress.METHOD_LZSS, window_bits, 0)
+        return header + content, len(data)
+    content = gzip.compress(data, mtime=0)
+    header = struct.pack('<IBBH', len(data), fstr_compress.METHOD_GZIP, 0, 0)
+    return header + content, len(content)
+
+
+def import_path(path, prefix):
+    """The prefix only applies to relative paths"""
+    if prefix and not os.path.isabs(path):
+        return '%s "/%s"' % (prefix, path.replace(os.sep, '/'))
+    return '"%s"' % os.path.abspath(path).replace(os.sep, '/')
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Generate a FlashString FileMap definition')
+    parser.add_argument('name', help='Name of FileMap to define')
+    parser.add_argument('directory', help='Directory containing files to import')
+    parser.add_argument('--prefix', help='Expression giving base directory for imported files, e.g. COMPONENT_PATH')
+    parser.add_argument('--compress', choices=['none', 'lzss', 'gzip'], default='none',
+                        help='Compression method for text files')
+    parser.add_argument('--min-size', type=int, default=256, help='Only compress files at least this size')
+    parser.add_argument('--window-bits', type=int, choices=range(8, 13), default=10, metavar='8-12',
+                        help='LZSS window size as power of 2 (default: 10, i.e. 1K)')
+    parser.add_argument('--output-dir', help='Where to write compressed files')
+    parser.add_argument('--local', action='store_true', help='Use DEFINE_FSTR_FILEMAP_LOCAL')
+    args = parser.parse_args()
+
+    if args.compress != 'none' and not args.output_dir:
+        sys.exit("--output-dir is required for compression")
+
+    files = []
+    for root, dirs, names in os.walk(args.directory):
+        dirs.sort()
+        for n in sorted(names):
+            files.append(os.path.relpath(os.path.join(root, n), args.directory))
+    if len(files) == 0 or len(files) > maphash.INDEX_MAX:
+        sys.exit("Directory must contain between 1 and %u files" % maphash.INDEX_MAX)
+
+    keys = [f.replace(os.sep, '/').encode() for f in files]
+    folded = set(bytes(maphash.fold_case(c) for c in k) for k in keys)
+    if len(folded) != len(keys):
+        sys.exit("Duplicate paths (paths must be unique ignoring case)")
+
+    for seed in range(1000):
+        res = maphash.generate(keys, seed)
+        if res:
+            break
+    else:
+        sys.exit("Failed to generate hash table")
+    index, slots = res
+
+    name = args.name
+    print('// Generated by filemap.py, do not edit')
+    print()
+    print('#include <FlashString/FileMap.hpp>')
+    print()
+    mimes = []
+    entries = []
+    for i, f in enumerate(files):
+        source = os.path.join(args.directory, f)
+        with open(source, 'rb') as fp:
+            data = fp.read()
+        mime = mime_type(f)
+        if mime not in mimes:
+            print('DEFINE_FSTR_LOCAL(%s_mime%u, "%s");' % (name, len(mimes), mime))
+            mimes.append(mime)
+
+        method = args.compress
+        if len(data) < args.min_size or not any(mime.startswith(t) for t in COMPRESSIBLE_TYPES):
+            method = 'none'
+        if method == 'none':
+            size = len(data)
+            print('IMPORT_FSTR_LOCAL(%s_file%u, %s);' % (name, i, import_path(source, args.prefix)))
+        else:
+            content, size = compress(data, method, args.window_bits)
+            output = os.path.join(args.output_dir, f + '.' + method)
+            os.makedirs(os.path.dirname(output), exist_ok=True)
+            with open(output, 'wb') as fp:
+                fp.write(content)
+            print('IMPORT_FSTR_COMPRESSED_LOCAL(%s_file%u, %s);' % (name, i, import_path(output, args.prefix)))
+        print('DEFINE_FSTR_LOCAL(%s_path%u, %s);' % (name, i, maphash.c_string(keys[i])))
+        entries.append('\t{&%s_path%u, &FSTR_DATA_NAME(%s_file%u), &%s_mime%u, %u, 0x%08x, %s}' %
+                       (name, i, name, i, name, mimes.index(mime), size, fstr_digest.digest(data), COMPRESSION[method]))
+
+    print('DEFINE_FSTR_ARRAY_LOCAL(%s_index, int16_t, %s);' % (name, ', '.join(str(d) for d in index)))
+    macro = 'DEFINE_FSTR_FILEMAP_LOCAL' if args.local else 'DEFINE_FSTR_FILEMAP'
+    print('%s(%s, %u, &%s_index,' % (macro, name, seed, name))
+    print(',\n'.join(entries[i] for i in slots) + ');')
+
+
+if __name__ == '__main__':
+    main()
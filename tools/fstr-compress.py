@@ -0,0 +1,148 @@
+#!/usr/bin/env python3
+#
+# fstr-compress.py - Compress a file for use with IMPORT_FSTR_COMPRESSED
+#
+# Copyright 2019 mikee47 <mike@sillyhouse.net>
+#
+# This file is part of the FlashString Library
+#
+# This library is free software: you can redistribute it and/or modify it under the terms of the
+# GNU General Public License as published by the Free Software Foundation, version 3 or later.
+#
+# This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+# without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+# See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this library.
+# If not, see <https://www.gnu.org/licenses/>.
+#
+# Output consists of an 8-byte header (see FSTR::CompressionHeader) followed by the content.
+#
+# lzss: Decompressed by FSTR::CompressedStream using a RAM window of 2^window-bits bytes.
+#       The encoding is described in CompressedStream.cpp.
+#
+# gzip: Content is gzipped and served as-is, with a Content-Encoding hint.
+#
+
+import argparse
+import gzip
+import struct
+
+METHOD_LZSS = 1
+METHOD_GZIP = 2
+
+MIN_MATCH = 3
+MAX_CHAIN = 64
+
+
+def lzss_compress(data, window_bits):
+    window_size = 1 << window_bits
+    max_match = MIN_MATCH + (1 << (16 - window_bits)) - 1
+    out = bytearray()
+    group = bytearray()
+    flags = 0
+    flag_count = 0
+    chains = {}
+
+    def insert(pos):
+        if pos + MIN_MATCH <= len(data):
+            chain = chains.setdefault(data[pos:pos + MIN_MATCH], [])
+            chain.append(pos)
+            if len(chain) > MAX_CHAIN * 2:
+                del chain[:MAX_CHAIN]
+
+    pos = 0
+    while pos < len(data):
+        best_length = 0
+        best_offset = 0
+        for candidate in reversed(chains.get(data[pos:pos + MIN_MATCH], [])[-MAX_CHAIN:]):
+            offset = pos - candidate
+            if offset > window_size:
+                break
+            length = MIN_MATCH
+            while length < max_match and pos + length < len(data) and data[candidate + length] == data[pos + length]:
+                length += 1
+            if length > best_length:
+                best_length, best_offset = length, offset
+                if length == max_match:
+                    break
+
+        if best_length >= MIN_MATCH:
+            token = (best_offset - 1) | ((best_length - MIN_MATCH) << window_bits)
+            group += struct.pack('<H', token)
+            for i in range(pos, pos + best_length):
+                insert(i)
+            pos += best_length
+        else:
+            flags |= 1 << flag_count
+            group.append(data[pos])
+            insert(pos)
+            pos += 1
+
+        flag_count += 1
+        if flag_count == 8:
+            out.append(flags)
+            out += group
+            group = bytearray()
+            flags = 0
+            flag_count = 0
+
+    if flag_count != 0:
+        out.append(flags)
+        out += group
+
+    return bytes(out)
+
+
+def lzss_decompress(data, window_bits):
+    """Reference decoder, used to verify output"""
+    out = bytearray()
+    pos = 0
+    while pos < len(data):
+        flags = data[pos]
+        pos += 1
+        for bit in range(8):
+            if pos >= len(data):
+                break
+            if flags & (1 << bit):
+                out.append(data[pos])
+                pos += 1
+            else:
+                token, = struct.unpack_from('<H', data, pos)
+                pos += 2
+                offset = (token & ((1 << window_bits) - 1)) + 1
+                length = (token >> window_bits) + MIN_MATCH
+                for _ in range(length):
+                    out.append(out[-offset])
+    return bytes(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Compress a file for use with IMPORT_FSTR_COMPRESSED')
+    parser.add_argument('input', help='File to compress')
+    parser.add_argument('output', help='Output file')
+    parser.add_argument('--method', choices=['lzss', 'gzip'], default='lzss', help='Compression method')
+    parser.add_argument('--window-bits', type=int, choices=range(8, 13), default=10, metavar='8-12',
+                        help='LZSS window size as power of 2 (default: 10, i.e. 1K)')
+    args = parser.parse_args()
+
+    with open(args.input, 'rb') as f:
+        data = f.read()
+
+    if args.method == 'lzss':
+        content = lzss_compress(data, args.window_bits)
+        assert lzss_decompress(content, args.window_bits) == data
+        header = struct.pack('<IBBH', len(data), METHOD_LZSS, args.window_bits, 0)
+    else:
+        content = gzip.compress(data, mtime=0)
+        header = struct.pack('<IBBH', len(data), METHOD_GZIP, 0, 0)
+
+    with open(args.output, 'wb') as f:
+        f.write(header)
+        f.write(content)
+
+    print('%s: %u -> %u bytes' % (args.output, len(data), len(header) + len(content)))
+
+
+if __name__ == '__main__':
+    main()
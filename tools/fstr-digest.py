@@ -0,0 +1,65 @@
+#!/usr/bin/env python3
+#
+# fstr-digest.py - Calculate content digest for use with IMPORT_FSTR_DIGEST
+#
+# Copyright 2019 mikee47 <mike@sillyhouse.net>
+#
+# This file is part of the FlashString Library
+#
+# This library is free software: you can redistribute it and/or modify it under the terms of the
+# GNU General Public License as published by the Free Software Foundation, version 3 or later.
+#
+# This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+# without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+# See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this library.
+# If not, see <https://www.gnu.org/licenses/>.
+#
+# The digest is a 32-bit FNV-1a hash of the file content, as calculated by FSTR::ObjectBase::digest().
+#
+# By default, the value for each file is printed. Use --define to produce a header file:
+#
+#   #define LOREM_TXT_DIGEST 0x12345678
+#
+
+import argparse
+import os
+import re
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from maphash import FNV_OFFSET_BASIS, FNV_PRIME, MASK
+
+
+def digest(data):
+    """Must match FSTR::Hash::updateDigest()"""
+    h = FNV_OFFSET_BASIS
+    for c in data:
+        h = ((h ^ c) * FNV_PRIME) & MASK
+    return h
+
+
+def macro_name(path):
+    return re.sub(r'[^A-Z0-9]', '_', os.path.basename(path).upper()) + '_DIGEST'
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Calculate digest for use with IMPORT_FSTR_DIGEST')
+    parser.add_argument('input', nargs='+', help='Files to process')
+    parser.add_argument('--define', action='store_true', help='Output #define statements')
+    args = parser.parse_args()
+
+    if args.define:
+        print('// Generated by fstr-digest.py, do not edit')
+    for path in args.input:
+        with open(path, 'rb') as f:
+            value = digest(f.read())
+        if args.define:
+            print('#define %s 0x%08x' % (macro_name(path), value))
+        else:
+            print('0x%08x %s' % (value, path))
+
+
+if __name__ == '__main__':
+    main()
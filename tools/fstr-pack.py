@@ -0,0 +1,114 @@
+#!/usr/bin/env python3
+#
+# fstr-pack.py - Encode a list of integers for use with IMPORT_FSTR_PACKED_ARRAY
+#
+# Copyright 2019 mikee47 <mike@sillyhouse.net>
+#
+# This file is part of the FlashString Library
+#
+# This library is free software: you can redistribute it and/or modify it under the terms of the
+# GNU General Public License as published by the Free Software Foundation, version 3 or later.
+#
+# This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+# without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+# See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this library.
+# If not, see <https://www.gnu.org/licenses/>.
+#
+# Input is a text file containing integers separated by whitespace or commas.
+# Values may be decimal, or hex with a 0x prefix.
+#
+# Output consists of an 8-byte header (see FSTR::PackedArrayHeader), a table giving the
+# offset of each block, then the encoded values.
+#
+# Values are split into blocks of --block-size elements. The first value in each block is stored
+# in full, subsequent ones as the difference from the previous value. Each is zigzag-encoded
+# so small negative differences are also small, then written as a little-endian base-128 varint.
+#
+
+import argparse
+import re
+import struct
+import sys
+
+TYPES = {
+    'int8': (1, True),
+    'uint8': (1, False),
+    'int16': (2, True),
+    'uint16': (2, False),
+    'int32': (4, True),
+    'uint32': (4, False),
+    'int64': (8, True),
+    'uint64': (8, False),
+}
+
+FLAG_SIGNED = 0x01
+MASK64 = (1 << 64) - 1
+
+
+def zigzag(n):
+    """Map signed 64-bit difference to unsigned: 0, -1, 1, -2, 2... => 0, 1, 2, 3, 4..."""
+    if n >= 1 << 63:
+        n -= 1 << 64
+    return ((n << 1) ^ (n >> 63)) & MASK64
+
+
+def varint(n):
+    out = bytearray()
+    while n >= 0x80:
+        out.append((n & 0x7f) | 0x80)
+        n >>= 7
+    out.append(n)
+    return out
+
+
+def encode(values, block_size):
+    """Returns (offsets, content)"""
+    offsets = []
+    content = bytearray()
+    prev = 0
+    for i, v in enumerate(values):
+        if i % block_size == 0:
+            offsets.append(len(content))
+            prev = 0
+        content += varint(zigzag((v - prev) & MASK64))
+        prev = v
+    return offsets, content
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Encode integers for use with IMPORT_FSTR_PACKED_ARRAY')
+    parser.add_argument('input', help='Text file containing values')
+    parser.add_argument('output', help='Output file')
+    parser.add_argument('--type', choices=TYPES.keys(), default='uint32', help='Element type (default: uint32)')
+    parser.add_argument('--block-size', type=int, default=32,
+                        help='Number of values between checkpoints (default: 32)')
+    args = parser.parse_args()
+
+    if not 1 <= args.block_size <= 0xffff:
+        sys.exit("Block size must be between 1 and 65535")
+
+    size, signed = TYPES[args.type]
+    bits = size * 8
+    low, high = (-(1 << (bits - 1)), (1 << (bits - 1)) - 1) if signed else (0, (1 << bits) - 1)
+
+    with open(args.input) as f:
+        values = [int(s, 0) for s in re.split(r'[\s,]+', f.read()) if s]
+    for v in values:
+        if not low <= v <= high:
+            sys.exit("Value %d out of range for %s" % (v, args.type))
+
+    offsets, content = encode(values, args.block_size)
+    header = struct.pack('<IBBH', len(values), size, FLAG_SIGNED if signed else 0, args.block_size)
+    table = struct.pack('<%uI' % len(offsets), *offsets)
+
+    with open(args.output, 'wb') as f:
+        f.write(header + table + content)
+
+    packed = len(header) + len(table) + len(content)
+    print("%u values, %u bytes packed (%u unpacked)" % (len(values), packed, len(values) * size))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,70 @@
+#!/usr/bin/env python3
+#
+# fstr-prefix.py - Generate an FSTR::PrefixVector definition from a list of strings
+#
+# Copyright 2019 mikee47 <mike@sillyhouse.net>
+#
+# This file is part of the FlashString Library
+#
+# This library is free software: you can redistribute it and/or modify it under the terms of the
+# GNU General Public License as published by the Free Software Foundation, version 3 or later.
+#
+# This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+# without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+# See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this library.
+# If not, see <https://www.gnu.org/licenses/>.
+#
+# Input is a text file with one entry per line. Blank lines are ignored.
+# The Vector keeps entries in the order given; the sort index lists them in order
+# ignoring case, as used by FSTR::PrefixVector.
+#
+# Output is written to stdout, suitable for inclusion in a source file.
+#
+
+import argparse
+import os
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import maphash
+
+INDEX_MAX = 0xffff
+
+
+def sort_key(entry):
+    """Must match PrefixVector::narrow()"""
+    return bytes(maphash.fold_case(c) for c in entry)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Generate an FSTR::PrefixVector definition')
+    parser.add_argument('name', help='Name of PrefixVector to define')
+    parser.add_argument('input', help='Text file containing entries, one per line')
+    parser.add_argument('--local', action='store_true', help='Use LOCAL definitions')
+    args = parser.parse_args()
+
+    with open(args.input, 'rb') as f:
+        entries = [line.rstrip(b'\r\n') for line in f]
+    entries = [e for e in entries if e]
+    if len(entries) == 0 or len(entries) > INDEX_MAX:
+        sys.exit("Input must contain between 1 and %u entries" % INDEX_MAX)
+
+    order = sorted(range(len(entries)), key=lambda i: sort_key(entries[i]))
+
+    name = args.name
+    local = '_LOCAL' if args.local else ''
+    print('// Generated by fstr-prefix.py, do not edit')
+    print()
+    print('#include <FlashString/PrefixVector.hpp>')
+    print()
+    for i, e in enumerate(entries):
+        print('DEFINE_FSTR_LOCAL(%s_%u, %s);' % (name, i, maphash.c_string(e)))
+    print('DEFINE_FSTR_ARRAY_LOCAL(%s_index, uint16_t, %s);' % (name, ', '.join(str(i) for i in order)))
+    print('DEFINE_FSTR_VECTOR_PREFIXED%s(%s, &%s_index,' % (local, name, name))
+    print(',\n'.join('\t&%s_%u' % (name, i) for i in range(len(entries))) + ');')
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,101 @@
+#!/usr/bin/env python3
+#
+# fstr-template.py - Generate a segment index for use with FSTR::IndexedTemplateStream
+#
+# Copyright 2019 mikee47 <mike@sillyhouse.net>
+#
+# This file is part of the FlashString Library
+#
+# This library is free software: you can redistribute it and/or modify it under the terms of the
+# GNU General Public License as published by the Free Software Foundation, version 3 or later.
+#
+# This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+# without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+# See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this library.
+# If not, see <https://www.gnu.org/licenses/>.
+#
+# The template is scanned for `{name}` markers, where `name` is an identifier.
+# Any other text, including braces, is literal.
+#
+# Output is written to stdout, suitable for inclusion in a source file. It defines:
+#
+#   name            FSTR::String                    Template content, imported from the file
+#   name_vars       FSTR::Vector<FSTR::String>      Variable names
+#   name_segments   FSTR::Array<TemplateSegment>    Segment index
+#
+
+import argparse
+import os
+import re
+import sys
+
+VAR_PATTERN = re.compile(rb'\{([A-Za-z_][A-Za-z0-9_]*)\}')
+MAX_LITERAL = 0xffff
+NO_VARIABLE = 0xffff
+
+
+def parse(data):
+    """Returns (variables, segments) where each segment is (offset, length, variable)"""
+    variables = []
+    segments = []
+
+    def add(offset, end, var):
+        while end - offset > MAX_LITERAL:
+            segments.append((offset, MAX_LITERAL, NO_VARIABLE))
+            offset += MAX_LITERAL
+        segments.append((offset, end - offset, var))
+
+    pos = 0
+    for m in VAR_PATTERN.finditer(data):
+        name = m.group(1).decode()
+        if name not in variables:
+            variables.append(name)
+        add(pos, m.start(), variables.index(name))
+        pos = m.end()
+    if pos < len(data):
+        add(pos, len(data), NO_VARIABLE)
+    return variables, segments
+
+
+def import_path(path, prefix):
+    path = path.replace(os.sep, '/')
+    if prefix:
+        return '%s "/%s"' % (prefix, path)
+    return '"%s"' % os.path.abspath(path).replace(os.sep, '/')
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Generate an FSTR::IndexedTemplateStream definition')
+    parser.add_argument('name', help='Name of template to define')
+    parser.add_argument('input', help='Template file')
+    parser.add_argument('--prefix', help='Expression giving base directory for imported file, e.g. PROJECT_DIR')
+    parser.add_argument('--local', action='store_true', help='Use LOCAL definitions')
+    args = parser.parse_args()
+
+    with open(args.input, 'rb') as f:
+        data = f.read()
+    variables, segments = parse(data)
+    if len(variables) == 0:
+        sys.exit("Template contains no variables, use FSTR::Stream instead")
+    if len(variables) >= NO_VARIABLE:
+        sys.exit("Too many variables")
+
+    name = args.name
+    local = '_LOCAL' if args.local else ''
+    print('// Generated by fstr-template.py, do not edit')
+    print()
+    print('#include <FlashString/IndexedTemplateStream.hpp>')
+    print()
+    print('IMPORT_FSTR%s(%s, %s);' % (local, name, import_path(args.input, args.prefix)))
+    for i, v in enumerate(variables):
+        print('DEFINE_FSTR_LOCAL(%s_var%u, "%s");' % (name, i, v))
+    print('DEFINE_FSTR_VECTOR%s(%s_vars, FSTR::String, %s);' %
+          (local, name, ', '.join('&%s_var%u' % (name, i) for i in range(len(variables)))))
+    print('DEFINE_FSTR_ARRAY%s(%s_segments, FSTR::TemplateSegment,' % (local, name))
+    print(',\n'.join('\t{%u, %u, 0x%04x}' % s for s in segments) + ');')
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,244 @@
+#!/usr/bin/env python3
+#
+# json2fstr.py - Translate a JSON document into FlashString definitions
+#
+# Copyright 2019 mikee47 <mike@sillyhouse.net>
+#
+# This file is part of the FlashString Library
+#
+# This library is free software: you can redistribute it and/or modify it under the terms of the
+# GNU General Public License as published by the Free Software Foundation, version 3 or later.
+#
+# This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+# without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+# See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this library.
+# If not, see <https://www.gnu.org/licenses/>.
+#
+# JSON values are translated as follows:
+#
+#   string      String
+#   number      Array<int32_t>, Array<int64_t> or Array<double> with one element
+#   true/false  Array<bool> with one element
+#   null        nullptr
+#   array       Array if all elements are numbers or all are booleans, otherwise Vector
+#   object      SortedMap with String keys, or HashedMap if --hashed is given
+#
+# Where all the elements of a Vector or Map have the same type, that type is used for the content.
+# Otherwise the content type is FSTR::ObjectBase, and FSTR::Variant must be used to access it.
+# This requires the application to be built with FSTR_TYPE_INFO=1.
+#
+# Identical strings and numbers are only defined once, including keys.
+#
+# Output is written to stdout, or to the file given by --output, suitable for compiling as a source file.
+# Use --header to also produce a header file declaring the root object.
+#
+
+import argparse
+import json
+import os
+import sys
+
+import maphash
+
+OBJECT_BASE = 'FSTR::ObjectBase'
+INT32_MIN = -0x80000000
+INT32_MAX = 0x7fffffff
+
+
+class Writer:
+    def __init__(self, name, hashed):
+        self.name = name
+        self.hashed = hashed
+        self.lines = []
+        self.aliases = []
+        self.objects = {}  # Maps content key -> (identifier, type)
+        self.counts = {}
+        self.untyped = False
+
+    def new_id(self, kind):
+        n = self.counts.get(kind, 0)
+        self.counts[kind] = n + 1
+        return '%s_%s%u' % (self.name, kind, n)
+
+    def alias(self, type_name):
+        """Macro arguments cannot contain commas, so use an alias for such types"""
+        if ',' not in type_name:
+            return type_name
+        for alias, t in self.aliases:
+            if t == type_name:
+                return alias
+        alias = '%s_type%u' % (self.name, len(self.aliases))
+        self.aliases.append((alias, type_name))
+        return alias
+
+    def define(self, key, kind, type_name, make_line, ident=None):
+        """Emit a definition, or re-use an existing identical one"""
+        if key is not None and key in self.objects:
+            return self.objects[key]
+        ident = ident or self.new_id(kind)
+        self.lines.append(make_line(ident))
+        res = (ident, type_name)
+        if key is not None:
+            self.objects[key] = res
+        return res
+
+    def string(self, value, ident=None, macro='DEFINE_FSTR_LOCAL'):
+        text = maphash.c_string(value.encode())
+        return self.define(('str', value), 'str', 'FSTR::String',
+                           lambda i: '%s(%s, %s);' % (macro, i, text), ident)
+
+    def array(self, values, ident=None, macro='DEFINE_FSTR_ARRAY_LOCAL'):
+        if all(isinstance(v, bool) for v in values):
+            element_type = 'bool'
+            items = ['true' if v else 'false' for v in values]
+        elif any(isinstance(v, float) for v in values):
+            element_type = 'double'
+            items = [repr(float(v)) for v in values]
+        elif all(INT32_MIN <= v <= INT32_MAX for v in values):
+            element_type = 'int32_t'
+            items = [str(v) for v in values]
+        else:
+            element_type = 'int64_t'
+            items = ['%dLL' % v for v in values]
+        key = ('arr', element_type, tuple(items))
+        return self.define(key, 'arr', 'FSTR::Array<%s>' % element_type,
+                           lambda i: '%s(%s, %s, %s);' % (macro, i, element_type, ', '.join(items)), ident)
+
+    @staticmethod
+    def pointer(child, content_type):
+        """Pointers to untyped content must refer directly to the data structure to remain constexpr"""
+        if child is None:
+            return 'nullptr'
+        if content_type == OBJECT_BASE:
+            return '&FSTR_DATA_NAME(%s).object' % child[0]
+        return '&' + child[0]
+
+    def content_type(self, children):
+        types = set(c[1] for c in children if c is not None)
+        if len(types) == 1:
+            return types.pop()
+        self.untyped = True
+        return OBJECT_BASE
+
+    def vector(self, values, ident=None, macro='DEFINE_FSTR_VECTOR_LOCAL'):
+        children = [self.value(v) for v in values]
+        content_type = self.content_type(children)
+        pointers = [self.pointer(c, content_type) for c in children]
+        ident = ident or self.new_id('vec')
+        ctype = self.alias(content_type)
+        if len(pointers) == 0:
+            self.lines.append('%s(%s, %s, 0);' % (macro.replace('VECTOR', 'VECTOR_SIZED'), ident, ctype))
+        else:
+            self.lines.append('%s(%s, %s, %s);' % (macro, ident, ctype, ', '.join(pointers)))
+        return ident, 'FSTR::Vector<%s>' % content_type
+
+    def map(self, obj, ident=None, local=True):
+        keys = list(obj.keys())
+        children = [self.value(obj[k]) for k in keys]
+        content_type = self.content_type(children)
+        key_ids = [self.string(k)[0] for k in keys]
+        entries = [(k, '{&%s, %s}' % (kid, self.pointer(c, content_type)))
+                   for k, kid, c in zip(keys, key_ids, children)]
+        ident = ident or self.new_id('map')
+        ctype = self.alias(content_type)
+        suffix = '_LOCAL' if local else ''
+
+        if len(entries) == 0:
+            self.lines.append('DEFINE_FSTR_MAP_SIZED%s(%s, FSTR::String, %s, 0);' % (suffix, ident, ctype))
+            return ident, 'FSTR::Map<FSTR::String, %s>' % content_type
+
+        if self.hashed:
+            encoded = [k.encode() for k in keys]
+            folded = set(bytes(maphash.fold_case(c) for c in k) for k in encoded)
+            if len(folded) == len(encoded) and len(encoded) <= maphash.INDEX_MAX:
+                for seed in range(1000):
+                    res = maphash.generate(encoded, seed)
+                    if res:
+                        index, slots = res
+                        index_id = self.array_index(ident, index)
+                        self.lines.append('DEFINE_FSTR_MAP_HASHED%s(%s, %s, %u, &%s,' %
+                                          (suffix, ident, ctype, seed, index_id))
+                        self.lines.append(',\n'.join('\t' + entries[i][1] for i in slots) + ');')
+                        return ident, 'FSTR::HashedMap<%s>' % content_type
+            sys.stderr.write('Cannot hash keys for "%s", using SortedMap\n' % ident)
+
+        # Order as for String::compare() with ignoreCase = true
+        entries.sort(key=lambda e: (bytes(maphash.fold_case(c) for c in e[0].encode()), e[0].encode()))
+        self.lines.append('DEFINE_FSTR_MAP_SORTED%s(%s, FSTR::String, %s,' % (suffix, ident, ctype))
+        self.lines.append(',\n'.join('\t' + e[1] for e in entries) + ');')
+        return ident, 'FSTR::SortedMap<FSTR::String, %s>' % content_type
+
+    def array_index(self, ident, index):
+        index_id = ident + '_index'
+        self.lines.append('DEFINE_FSTR_ARRAY_LOCAL(%s, int16_t, %s);' % (index_id, ', '.join(str(d) for d in index)))
+        return index_id
+
+    def value(self, value, ident=None, local=True):
+        if value is None:
+            if ident:
+                sys.exit("Root value cannot be null")
+            return None
+        if isinstance(value, str):
+            return self.string(value, ident, 'DEFINE_FSTR_LOCAL' if local else 'DEFINE_FSTR')
+        if isinstance(value, (bool, int, float)):
+            return self.array([value], ident, 'DEFINE_FSTR_ARRAY_LOCAL' if local else 'DEFINE_FSTR_ARRAY')
+        if isinstance(value, list):
+            numbers = len(value) != 0 and all(isinstance(v, (int, float)) and not isinstance(v, bool) for v in value)
+            bools = len(value) != 0 and all(isinstance(v, bool) for v in value)
+            if numbers or bools:
+                return self.array(value, ident, 'DEFINE_FSTR_ARRAY_LOCAL' if local else 'DEFINE_FSTR_ARRAY')
+            return self.vector(value, ident, 'DEFINE_FSTR_VECTOR_LOCAL' if local else 'DEFINE_FSTR_VECTOR')
+        if isinstance(value, dict):
+            return self.map(value, ident, local)
+        sys.exit("Unsupported JSON value %r" % value)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Translate a JSON document into FlashString definitions')
+    parser.add_argument('name', help='Name of the root object to define')
+    parser.add_argument('input', nargs='?', type=argparse.FileType('r'), default=sys.stdin, help='JSON file')
+    parser.add_argument('--output', '-o', type=argparse.FileType('w'), default=sys.stdout, help='Source file to write')
+    parser.add_argument('--header', help='Header file to write, declaring the root object')
+    parser.add_argument('--hashed', action='store_true', help='Use HashedMap instead of SortedMap for JSON objects')
+    parser.add_argument('--local', action='store_true', help='Define root object as static')
+    args = parser.parse_args()
+
+    doc = json.load(args.input)
+
+    writer = Writer(args.name, args.hashed)
+    _, type_name = writer.value(doc, args.name, args.local)
+    # Must be done before aliases are written
+    root_type = writer.alias(type_name)
+
+    includes = sorted(set(['<FlashString/String.hpp>', '<FlashString/Array.hpp>', '<FlashString/Vector.hpp>',
+                           '<FlashString/SortedMap.hpp>'] + (['<FlashString/HashedMap.hpp>'] if args.hashed else [])))
+    preamble = ['#include %s' % i for i in includes]
+    aliases = ['using %s = %s;' % a for a in writer.aliases]
+
+    out = args.output
+    out.write('// Generated by json2fstr.py, do not edit\n\n')
+    if args.header:
+        out.write('#include "%s"\n' % os.path.basename(args.header))
+    else:
+        out.write('\n'.join(preamble) + '\n')
+        if aliases:
+            out.write('\n' + '\n'.join(aliases) + '\n')
+    if writer.untyped:
+        out.write('\n#if !FSTR_TYPE_INFO\n'
+                  '#warning "Mixed content requires FSTR_TYPE_INFO=1 for access using FSTR::Variant"\n'
+                  '#endif\n')
+    out.write('\n' + '\n'.join(writer.lines) + '\n')
+
+    if args.header:
+        with open(args.header, 'w') as f:
+            f.write('// Generated by json2fstr.py, do not edit\n\n#pragma once\n\n')
+            f.write('\n'.join(preamble) + '\n')
+            if aliases:
+                f.write('\n' + '\n'.join(aliases) + '\n')
+            f.write('\nDECLARE_FSTR_OBJECT(%s, %s)\n' % (args.name, root_type))
+
+
+if __name__ == '__main__':
+    main()
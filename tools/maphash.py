@@ -0,0 +1,153 @@
+#!/usr/bin/env python3
+#
+# maphash.py - Generate a perfect-hashed FlashString Map definition
+#
+# Copyright 2019 mikee47 <mike@sillyhouse.net>
+#
+# This file is part of the FlashString Library
+#
+# This library is free software: you can redistribute it and/or modify it under the terms of the
+# GNU General Public License as published by the Free Software Foundation, version 3 or later.
+#
+# This library is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+# without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+# See the GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along with this library.
+# If not, see <https://www.gnu.org/licenses/>.
+#
+# Input is a text file with one entry per line:
+#
+#   key content
+#
+# Where `key` is the map key text and `content` is a C++ expression giving a pointer to the content,
+# such as `&content1`. Blank lines and lines starting with '#' are ignored.
+#
+# Output is written to stdout, suitable for inclusion in a source file.
+#
+
+import argparse
+import sys
+
+FNV_OFFSET_BASIS = 2166136261
+FNV_PRIME = 16777619
+MASK = 0xffffffff
+INDEX_MAX = 0x7fff
+
+
+def fold_case(c):
+    return c + 0x20 if 0x41 <= c <= 0x5a else c
+
+
+def hash_key(key):
+    """Must match FSTR::Hash::calculate()"""
+    h = FNV_OFFSET_BASIS
+    for c in key:
+        h = ((h ^ fold_case(c)) * FNV_PRIME) & MASK
+    return h
+
+
+def mix(h):
+    """Must match FSTR::Hash::mix()"""
+    h = ((h ^ (h >> 16)) * 0x85ebca6b) & MASK
+    h = ((h ^ (h >> 13)) * 0xc2b2ae35) & MASK
+    return h ^ (h >> 16)
+
+
+def generate(keys, seed):
+    """Build displacement table using hash and displace, returns (index, slots) or None on failure"""
+    count = len(keys)
+    index_length = max(1, (count + 1) // 2)
+    hashes = [mix(hash_key(k) ^ seed) for k in keys]
+    buckets = [[] for _ in range(index_length)]
+    for i, h in enumerate(hashes):
+        buckets[h % index_length].append(i)
+    index = [0] * index_length
+    slots = [None] * count
+
+    # Place largest buckets first, whilst there's the most room
+    order = sorted(range(index_length), key=lambda b: len(buckets[b]), reverse=True)
+    singles = []
+    for b in order:
+        items = buckets[b]
+        if len(items) == 0:
+            break
+        if len(items) == 1:
+            singles.append(b)
+            continue
+        for d in range(INDEX_MAX + 1):
+            candidates = [mix(hashes[i] ^ d) % count for i in items]
+            if len(set(candidates)) == len(items) and all(slots[s] is None for s in candidates):
+                break
+        else:
+            return None
+        index[b] = d
+        for i, s in zip(items, candidates):
+            slots[s] = i
+
+    # Single-entry buckets index their slot directly
+    free = [s for s in range(count) if slots[s] is None]
+    for b, s in zip(singles, free):
+        index[b] = -s - 1
+        slots[s] = buckets[b][0]
+
+    return index, slots
+
+
+def c_string(key):
+    s = ''
+    for c in key:
+        if c in b'\\"':
+            s += '\\' + chr(c)
+        elif 0x20 <= c < 0x7f:
+            s += chr(c)
+        else:
+            s += '\\%03o' % c
+    return '"' + s + '"'
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Generate a FlashString HashedMap definition')
+    parser.add_argument('name', help='Name of map to define')
+    parser.add_argument('content_type', help='Content type, e.g. FSTR::String')
+    parser.add_argument('input', nargs='?', type=argparse.FileType('r'), default=sys.stdin,
+                        help='Input file, one "key content" entry per line')
+    parser.add_argument('--local', action='store_true', help='Use DEFINE_FSTR_MAP_HASHED_LOCAL')
+    args = parser.parse_args()
+
+    entries = []
+    for line in args.input:
+        line = line.strip()
+        if line == '' or line.startswith('#'):
+            continue
+        key, content = line.split(None, 1)
+        entries.append((key.encode(), content.strip()))
+
+    keys = [e[0] for e in entries]
+    folded = set(bytes(fold_case(c) for c in k) for k in keys)
+    if len(folded) != len(keys):
+        sys.exit("Duplicate keys (keys must be unique ignoring case)")
+    if len(keys) == 0 or len(keys) > INDEX_MAX:
+        sys.exit("Map must contain between 1 and %u entries" % INDEX_MAX)
+
+    for seed in range(1000):
+        res = generate(keys, seed)
+        if res:
+            break
+    else:
+        sys.exit("Failed to generate hash table")
+    index, slots = res
+
+    name = args.name
+    print('// Generated by maphash.py, do not edit')
+    for i, (key, _) in enumerate(entries):
+        print('DEFINE_FSTR_LOCAL(%s_key%u, %s);' % (name, i, c_string(key)))
+    print('DEFINE_FSTR_ARRAY_LOCAL(%s_index, int16_t, %s);' % (name, ', '.join(str(d) for d in index)))
+    macro = 'DEFINE_FSTR_MAP_HASHED_LOCAL' if args.local else 'DEFINE_FSTR_MAP_HASHED'
+    print('%s(%s, %s, %u, &%s_index,' % (macro, name, args.content_type, seed, name))
+    pairs = ['\t{&%s_key%u, %s}' % (name, i, entries[i][1]) for i in slots]
+    print(',\n'.join(pairs) + ');')
+
+
+if __name__ == '__main__':
+    main()